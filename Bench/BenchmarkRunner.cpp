@@ -0,0 +1,432 @@
+/*
+  ==============================================================================
+    RIPPLE - Benchmark Runner Implementation
+  ==============================================================================
+*/
+
+#include "BenchmarkRunner.h"
+#include "PluginProcessor.h"
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace RippleBench
+{
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+
+        // Copies the next block of the (looped) input into the block buffer
+        void fillBlock(juce::AudioBuffer<float>& block, const juce::AudioBuffer<float>& input, int& readPos)
+        {
+            const int numSamples = block.getNumSamples();
+            const int inputLength = input.getNumSamples();
+
+            int written = 0;
+            while (written < numSamples)
+            {
+                const int count = juce::jmin(numSamples - written, inputLength - readPos);
+                for (int ch = 0; ch < block.getNumChannels(); ++ch)
+                    block.copyFrom(ch, written, input, ch % input.getNumChannels(), readPos, count);
+
+                written += count;
+                readPos = (readPos + count) % inputLength;
+            }
+        }
+
+        void applySettings(SpectralProcessor& spectral, const EffectSettings& fx)
+        {
+            spectral.setFreezeAmount(fx.freeze);
+            spectral.setSmearAmount(fx.smear);
+            spectral.setScatterAmount(fx.scatter);
+            spectral.setShiftAmount(fx.shift);
+            spectral.setTiltAmount(fx.tilt);
+            spectral.setFeedbackAmount(fx.feedback);
+            spectral.setStereoLinked(fx.stereoLinked);
+        }
+
+        void applySettings(RippleProcessor& processor, const EffectSettings& fx)
+        {
+            setParameter(processor, "freeze", fx.freeze);
+            setParameter(processor, "smear", fx.smear);
+            setParameter(processor, "scatter", fx.scatter);
+            setParameter(processor, "shift", fx.shift);
+            setParameter(processor, "tilt", fx.tilt);
+            setParameter(processor, "feedback", fx.feedback);
+            setParameter(processor, "stereo_link", fx.stereoLinked ? 1.0f : 0.0f);
+        }
+
+        juce::String targetName(Target target)
+        {
+            return target == Target::spectralProcessor ? "SpectralProcessor" : "RippleProcessor";
+        }
+
+        // Mean time per call of fn over numIterations calls
+        template <typename Fn>
+        double timeCalls(int numIterations, Fn&& fn)
+        {
+            const auto start = Clock::now();
+            for (int i = 0; i < numIterations; ++i)
+                fn();
+            const auto end = Clock::now();
+
+            return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count())
+                   / juce::jmax(1, numIterations);
+        }
+    }
+
+    //==============================================================================
+    void setParameter(RippleProcessor& processor, const char* id, float value)
+    {
+        if (auto* param = processor.getAPVTS().getParameter(id))
+            param->setValueNotifyingHost(param->convertTo0to1(value));
+    }
+
+    juce::StringArray getSyntheticInputNames()
+    {
+        return { "noise", "sweep", "impulses", "silence" };
+    }
+
+    juce::AudioBuffer<float> makeSyntheticInput(const juce::String& name, double sampleRate,
+                                                int numChannels, int numSamples)
+    {
+        juce::AudioBuffer<float> buffer(numChannels, numSamples);
+        buffer.clear();
+
+        // Fixed seed so every run sees the same signal
+        juce::Random random(0x5249504c);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            float* data = buffer.getWritePointer(ch);
+
+            if (name == "noise")
+            {
+                for (int i = 0; i < numSamples; ++i)
+                    data[i] = (random.nextFloat() * 2.0f - 1.0f) * 0.5f;
+            }
+            else if (name == "sweep")
+            {
+                // Exponential sine sweep 20 Hz -> 20 kHz over the buffer length
+                const double f0 = 20.0;
+                const double f1 = juce::jmin(20000.0, sampleRate * 0.45);
+                const double duration = numSamples / sampleRate;
+                const double k = std::log(f1 / f0);
+                const double channelOffset = ch * 0.25 * juce::MathConstants<double>::pi;
+
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    const double t = i / sampleRate;
+                    const double phase = juce::MathConstants<double>::twoPi * f0 * duration / k
+                                         * (std::exp(t * k / duration) - 1.0);
+                    data[i] = 0.5f * static_cast<float>(std::sin(phase + channelOffset));
+                }
+            }
+            else if (name == "impulses")
+            {
+                const int spacing = juce::jmax(1, static_cast<int>(sampleRate * 0.25));
+                for (int i = ch * 7; i < numSamples; i += spacing)
+                    data[i] = 0.9f;
+            }
+        }
+
+        return buffer;
+    }
+
+    juce::AudioBuffer<float> loadInputFile(const juce::File& file, int numChannels)
+    {
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+
+        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+        if (reader == nullptr || reader->lengthInSamples <= 0)
+            return {};
+
+        const int length = static_cast<int>(juce::jmin<juce::int64>(reader->lengthInSamples,
+                                                                     std::numeric_limits<int>::max()));
+        juce::AudioBuffer<float> buffer(numChannels, length);
+        reader->read(&buffer, 0, length, 0, true, numChannels > 1);
+        return buffer;
+    }
+
+    juce::Array<EffectSettings> getEffectMatrix()
+    {
+        juce::Array<EffectSettings> matrix;
+
+        EffectSettings dry;
+        matrix.add(dry);
+
+        EffectSettings fx;
+        fx.name = "freeze";   fx.freeze = 0.8f;   matrix.add(fx); fx = {};
+        fx.name = "smear";    fx.smear = 0.7f;    matrix.add(fx); fx = {};
+        fx.name = "scatter";  fx.scatter = 0.5f;  matrix.add(fx); fx = {};
+        fx.name = "shift";    fx.shift = 0.5f;    matrix.add(fx); fx = {};
+        fx.name = "tilt";     fx.tilt = -0.6f;    matrix.add(fx); fx = {};
+        fx.name = "feedback"; fx.feedback = 0.6f; matrix.add(fx); fx = {};
+
+        EffectSettings all;
+        all.name = "all";
+        all.freeze = 0.6f;
+        all.smear = 0.5f;
+        all.scatter = 0.3f;
+        all.shift = 0.25f;
+        all.tilt = 0.4f;
+        all.feedback = 0.4f;
+        matrix.add(all);
+
+        all.name = "all-linked";
+        all.stereoLinked = true;
+        matrix.add(all);
+
+        return matrix;
+    }
+
+    //==============================================================================
+    BenchResult run(const BenchConfig& config, const juce::AudioBuffer<float>& input,
+                    const juce::String& inputName)
+    {
+        BenchResult result;
+        result.config = config;
+        result.inputName = inputName;
+
+        if (input.getNumSamples() == 0 || config.blockSize <= 0)
+            return result;
+
+        const int numChannels = config.numChannels;
+        const int blockSize = config.blockSize;
+
+        std::unique_ptr<SpectralProcessor> spectral;
+        std::unique_ptr<RippleProcessor> processor;
+
+        if (config.target == Target::spectralProcessor)
+        {
+            spectral = std::make_unique<SpectralProcessor>();
+            spectral->prepare(config.sampleRate, blockSize);
+            spectral->setFrameSize(config.fftOrder > 0 ? config.fftOrder
+                                                       : SpectralProcessor::getAutoFFTOrder(config.sampleRate),
+                                   config.overlap);
+            spectral->setPipelined(config.pipelined);
+            spectral->updatePoolMembership(config.pipelined);
+            applySettings(*spectral, config.effects);
+        }
+        else
+        {
+            processor = std::make_unique<RippleProcessor>();
+
+            // Choice indices: fft_size 0 = Auto, 1.. = 256..; overlap 0/1/2 = 2x/4x/8x
+            setParameter(*processor, "fft_size", config.fftOrder > 0
+                                                     ? static_cast<float>(config.fftOrder - SpectralProcessor::MIN_FFT_ORDER + 1)
+                                                     : 0.0f);
+            setParameter(*processor, "overlap", config.overlap <= 2 ? 0.0f : (config.overlap >= 8 ? 2.0f : 1.0f));
+            setParameter(*processor, "pipelined", config.pipelined ? 1.0f : 0.0f);
+
+            processor->setRateAndBufferSizeDetails(config.sampleRate, blockSize);
+            processor->prepareToPlay(config.sampleRate, blockSize);
+            applySettings(*processor, config.effects);
+        }
+
+        const SpectralProcessor& frameSource = spectral != nullptr ? *spectral
+                                                                   : processor->getSpectralProcessor();
+
+        juce::AudioBuffer<float> block(numChannels, blockSize);
+        juce::MidiBuffer midi;
+        int readPos = 0;
+
+        auto processOneBlock = [&]
+        {
+            if (spectral != nullptr)
+                spectral->process(block);
+            else
+                processor->processBlock(block, midi);
+        };
+
+        // Warm up caches and let feedback/smear state settle before timing
+        const auto warmupBlocks = static_cast<juce::int64>(config.warmupSeconds * config.sampleRate / blockSize);
+        for (juce::int64 i = 0; i < warmupBlocks; ++i)
+        {
+            fillBlock(block, input, readPos);
+            processOneBlock();
+        }
+
+        const auto numBlocks = juce::jmax<juce::int64>(1, static_cast<juce::int64>(config.seconds * config.sampleRate / blockSize));
+
+        if (processor != nullptr)
+            processor->resetDSPStats();
+
+        double totalNs = 0.0;
+        double worstNs = 0.0;
+        const auto framesBefore = frameSource.getNumFramesProcessed();
+
+        for (juce::int64 i = 0; i < numBlocks; ++i)
+        {
+            const auto framesAtStart = frameSource.getNumFramesProcessed();
+
+            fillBlock(block, input, readPos);
+
+            const auto start = Clock::now();
+            processOneBlock();
+            const auto end = Clock::now();
+
+            const double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+            totalNs += ns;
+            worstNs = juce::jmax(worstNs, ns);
+
+            const auto frames = static_cast<int>(frameSource.getNumFramesProcessed() - framesAtStart);
+            result.maxFramesPerBlock = juce::jmax(result.maxFramesPerBlock, frames);
+        }
+
+        result.fftSize = frameSource.getFFTSize();
+        result.latencySamples = frameSource.getLatencySamples();
+        result.numBlocks = numBlocks;
+        result.numSamples = numBlocks * blockSize;
+        result.numFrames = frameSource.getNumFramesProcessed() - framesBefore;
+
+        result.nsPerSample = totalNs / static_cast<double>(result.numSamples);
+        result.meanBlockNs = totalNs / static_cast<double>(numBlocks);
+        result.worstBlockNs = worstNs;
+        result.realtimeFactor = totalNs > 0.0 ? (result.numSamples / config.sampleRate) * 1.0e9 / totalNs : 0.0;
+        result.meanFramesPerBlock = static_cast<double>(result.numFrames) / static_cast<double>(numBlocks);
+
+        if (processor != nullptr)
+        {
+            result.hasDSPStats = true;
+            result.dspStats = processor->readDSPStats();
+        }
+
+        return result;
+    }
+
+    juce::var toVar(const BenchResult& result)
+    {
+        juce::DynamicObject::Ptr effects = new juce::DynamicObject();
+        effects->setProperty("freeze", result.config.effects.freeze);
+        effects->setProperty("smear", result.config.effects.smear);
+        effects->setProperty("scatter", result.config.effects.scatter);
+        effects->setProperty("shift", result.config.effects.shift);
+        effects->setProperty("tilt", result.config.effects.tilt);
+        effects->setProperty("feedback", result.config.effects.feedback);
+        effects->setProperty("stereoLinked", result.config.effects.stereoLinked);
+
+        juce::DynamicObject::Ptr obj = new juce::DynamicObject();
+        obj->setProperty("target", targetName(result.config.target));
+        obj->setProperty("input", result.inputName);
+        obj->setProperty("preset", result.config.effects.name);
+        obj->setProperty("effects", juce::var(effects.get()));
+        obj->setProperty("sampleRate", result.config.sampleRate);
+        obj->setProperty("blockSize", result.config.blockSize);
+        obj->setProperty("numChannels", result.config.numChannels);
+        obj->setProperty("fftSize", result.fftSize);
+        obj->setProperty("overlap", result.config.overlap);
+        obj->setProperty("pipelined", result.config.pipelined);
+        obj->setProperty("latencySamples", result.latencySamples);
+        obj->setProperty("numBlocks", result.numBlocks);
+        obj->setProperty("numFrames", result.numFrames);
+        obj->setProperty("nsPerSample", result.nsPerSample);
+        obj->setProperty("meanBlockNs", result.meanBlockNs);
+        obj->setProperty("worstBlockNs", result.worstBlockNs);
+        obj->setProperty("realtimeFactor", result.realtimeFactor);
+        obj->setProperty("meanFramesPerBlock", result.meanFramesPerBlock);
+        obj->setProperty("maxFramesPerBlock", result.maxFramesPerBlock);
+
+        if (result.hasDSPStats)
+        {
+            const auto& stats = result.dspStats;
+
+            juce::Array<juce::var> histogram;
+            for (auto count : stats.histogram)
+                histogram.add(count);
+
+            juce::DynamicObject::Ptr dsp = new juce::DynamicObject();
+            dsp->setProperty("numBlocks", stats.numBlocks);
+            dsp->setProperty("meanBlockMs", stats.meanBlockMs);
+            dsp->setProperty("framesPerBlock", stats.framesPerBlock);
+            dsp->setProperty("maxFramesPerBlock", stats.maxFramesPerBlock);
+            dsp->setProperty("worstLoad", stats.worstLoad);
+            dsp->setProperty("loadHistogram", histogram);   // Blocks per 10% of budget, last = overruns
+            obj->setProperty("dspStats", juce::var(dsp.get()));
+        }
+
+        return juce::var(obj.get());
+    }
+
+    //==============================================================================
+    StateResult runState(int numIterations)
+    {
+        StateResult result;
+        result.numIterations = juce::jmax(1, numIterations);
+
+        // A session as a user would save one: effects on and a spectrum
+        // frozen from a second of noise at the default frame size
+        RippleProcessor processor;
+        EffectSettings fx;
+        fx.freeze = 0.8f;
+        fx.smear = 0.5f;
+        fx.tilt = 0.3f;
+        applySettings(processor, fx);
+
+        constexpr double sampleRate = 48000.0;
+        constexpr int blockSize = 512;
+        processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+
+        const auto noise = makeSyntheticInput("noise", sampleRate, 2, static_cast<int>(sampleRate));
+        juce::AudioBuffer<float> block(2, blockSize);
+        juce::MidiBuffer midi;
+        int readPos = 0;
+
+        for (int i = 0; i <= noise.getNumSamples() / blockSize; ++i)
+        {
+            // Freeze off for the last block holds the spectrum, so every save sees the same one
+            if (i == noise.getNumSamples() / blockSize)
+                setParameter(processor, "freeze", 0.0f);
+
+            fillBlock(block, noise, readPos);
+            processor.processBlock(block, midi);
+        }
+
+        juce::MemoryBlock binary;
+        result.saveNs = timeCalls(result.numIterations, [&]
+        {
+            binary.reset();
+            processor.getStateInformation(binary);
+        });
+
+        result.recallNs = timeCalls(result.numIterations, [&]
+        {
+            processor.setStateInformation(binary.getData(), static_cast<int>(binary.getSize()));
+        });
+
+        // The version 2 format: the APVTS tree as XML, without the spectrum
+        juce::MemoryBlock xml;
+        result.xmlSaveNs = timeCalls(result.numIterations, [&]
+        {
+            std::unique_ptr<juce::XmlElement> element(processor.getAPVTS().copyState().createXml());
+            element->setAttribute("stateVersion", 2);
+            xml.reset();
+            juce::AudioProcessor::copyXmlToBinary(*element, xml);
+        });
+
+        result.xmlRecallNs = timeCalls(result.numIterations, [&]
+        {
+            processor.setStateInformation(xml.getData(), static_cast<int>(xml.getSize()));
+        });
+
+        result.binaryBytes = static_cast<juce::int64>(binary.getSize());
+        result.xmlBytes = static_cast<juce::int64>(xml.getSize());
+        return result;
+    }
+
+    juce::var toVar(const StateResult& result)
+    {
+        juce::DynamicObject::Ptr obj = new juce::DynamicObject();
+        obj->setProperty("numIterations", result.numIterations);
+        obj->setProperty("binaryBytes", result.binaryBytes);
+        obj->setProperty("xmlBytes", result.xmlBytes);
+        obj->setProperty("saveNs", result.saveNs);
+        obj->setProperty("recallNs", result.recallNs);
+        obj->setProperty("xmlSaveNs", result.xmlSaveNs);
+        obj->setProperty("xmlRecallNs", result.xmlRecallNs);
+        return juce::var(obj.get());
+    }
+}
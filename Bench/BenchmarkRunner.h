@@ -0,0 +1,115 @@
+/*
+  ==============================================================================
+    RIPPLE - Benchmark Runner
+    Headless timing of SpectralProcessor and RippleProcessor::processBlock,
+    and of saving and recalling RippleProcessor's session state
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_core/juce_core.h>
+#include "DSPStats.h"
+#include "SpectralProcessor.h"
+
+class RippleProcessor;
+
+namespace RippleBench
+{
+    enum class Target
+    {
+        spectralProcessor,  // SpectralProcessor::process only
+        pluginProcessor     // RippleProcessor::processBlock (params, metering, spectral)
+    };
+
+    // Effect settings applied for a run (same ranges as the plugin parameters)
+    struct EffectSettings
+    {
+        juce::String name = "dry";
+        float freeze = 0.0f;
+        float smear = 0.0f;
+        float scatter = 0.0f;
+        float shift = 0.0f;
+        float tilt = 0.0f;
+        float feedback = 0.0f;
+        bool stereoLinked = false;
+    };
+
+    struct BenchConfig
+    {
+        Target target = Target::spectralProcessor;
+        double sampleRate = 48000.0;
+        int blockSize = 512;
+        int numChannels = 2;
+        double seconds = 5.0;
+        double warmupSeconds = 0.5;
+        int fftOrder = 0;   // 0 = automatic for the sample rate
+        int overlap = SpectralProcessor::DEFAULT_OVERLAP;
+        bool pipelined = false;
+        EffectSettings effects;
+    };
+
+    struct BenchResult
+    {
+        BenchConfig config;
+        juce::String inputName;
+        int fftSize = 0;
+        int latencySamples = 0;
+
+        juce::int64 numBlocks = 0;
+        juce::int64 numSamples = 0;
+        juce::int64 numFrames = 0;
+
+        double nsPerSample = 0.0;
+        double meanBlockNs = 0.0;
+        double worstBlockNs = 0.0;
+        double realtimeFactor = 0.0;     // audio duration / processing time
+        double meanFramesPerBlock = 0.0;
+        int maxFramesPerBlock = 0;
+
+        // RippleProcessor's own stats over the timed blocks, as the editor
+        // would see them (pluginProcessor target only)
+        bool hasDSPStats = false;
+        DSPStats::Snapshot dspStats;
+    };
+
+    // Sets a plugin parameter in its own units, as a host would; unknown IDs
+    // are ignored. Shared with the test targets.
+    void setParameter(RippleProcessor& processor, const char* id, float value);
+
+    // Synthetic inputs: "noise", "sweep", "impulses", "silence"
+    juce::StringArray getSyntheticInputNames();
+    juce::AudioBuffer<float> makeSyntheticInput(const juce::String& name, double sampleRate,
+                                                int numChannels, int numSamples);
+
+    // Loads a WAV/AIFF file; returns an empty buffer on failure
+    juce::AudioBuffer<float> loadInputFile(const juce::File& file, int numChannels);
+
+    // Standard effect matrix: dry, each effect alone, and everything combined
+    juce::Array<EffectSettings> getEffectMatrix();
+
+    // Runs one configuration, looping the input as needed
+    BenchResult run(const BenchConfig& config, const juce::AudioBuffer<float>& input,
+                    const juce::String& inputName);
+
+    juce::var toVar(const BenchResult& result);
+
+    // getStateInformation / setStateInformation on a session holding a
+    // frozen spectrum, against the APVTS XML of builds before the binary
+    // state. Times are the mean of numIterations calls each.
+    struct StateResult
+    {
+        int numIterations = 0;
+        juce::int64 binaryBytes = 0;
+        juce::int64 xmlBytes = 0;
+        double saveNs = 0.0;
+        double recallNs = 0.0;
+        double xmlSaveNs = 0.0;
+        double xmlRecallNs = 0.0;
+    };
+
+    StateResult runState(int numIterations);
+
+    juce::var toVar(const StateResult& result);
+}
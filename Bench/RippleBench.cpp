@@ -0,0 +1,174 @@
+/*
+  ==============================================================================
+    RIPPLE - Headless Benchmark
+    Runs the spectral engine over a matrix of sample rates, host block sizes
+    and effect settings and prints the results as JSON. --state adds the
+    time to save and recall a session, binary against the old XML.
+
+    Usage:
+      RippleBench [--quick] [--input file.wav | --signal noise|sweep|impulses|silence]
+                  [--output results.json]
+                  [--seconds 5] [--target spectral|processor|both]
+                  [--rates 44100,48000,96000] [--blocks 64,256,1024]
+                  [--fft auto|256..8192] [--overlap 2|4|8] [--pipelined]
+                  [--state [iterations]]
+  ==============================================================================
+*/
+
+#include "BenchmarkRunner.h"
+#include <juce_gui_basics/juce_gui_basics.h>
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+    juce::Array<int> parseIntList(const juce::String& text, const juce::Array<int>& defaults)
+    {
+        if (text.isEmpty())
+            return defaults;
+
+        juce::Array<int> values;
+        for (const auto& token : juce::StringArray::fromTokens(text, ",", {}))
+            if (token.getIntValue() > 0)
+                values.add(token.getIntValue());
+
+        return values.isEmpty() ? defaults : values;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // RippleProcessor owns an APVTS, which needs the message manager to exist
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ArgumentList args(argc, argv);
+
+    const bool quick = args.containsOption("--quick");
+    const auto targetOption = args.getValueForOption("--target");
+    const auto secondsOption = args.getValueForOption("--seconds");
+    const double seconds = secondsOption.isNotEmpty() ? secondsOption.getDoubleValue()
+                                                      : (quick ? 1.0 : 5.0);
+
+    const auto sampleRates = parseIntList(args.getValueForOption("--rates"),
+                                          quick ? juce::Array<int> { 48000 }
+                                                : juce::Array<int> { 44100, 48000, 96000 });
+    const auto blockSizes = parseIntList(args.getValueForOption("--blocks"),
+                                         quick ? juce::Array<int> { 64, 512 }
+                                               : juce::Array<int> { 32, 64, 128, 256, 512, 1024, 2048 });
+
+    // FFT size as a power of two, 0 = automatic for the sample rate
+    const int fftSizeOption = args.getValueForOption("--fft").getIntValue();
+    const int fftOrder = fftSizeOption > 0 ? juce::roundToInt(std::log2(fftSizeOption)) : 0;
+    const auto overlapOption = args.getValueForOption("--overlap");
+    const int overlap = overlapOption.isNotEmpty() ? overlapOption.getIntValue() : SpectralProcessor::DEFAULT_OVERLAP;
+    const bool pipelined = args.containsOption("--pipelined");
+
+    juce::Array<RippleBench::Target> targets;
+    if (targetOption.isEmpty() || targetOption == "both" || targetOption == "spectral")
+        targets.add(RippleBench::Target::spectralProcessor);
+    if (targetOption.isEmpty() || targetOption == "both" || targetOption == "processor")
+        targets.add(RippleBench::Target::pluginProcessor);
+
+    constexpr int numChannels = 2;
+
+    // Input: a WAV/AIFF file if given, otherwise the synthetic noise signal.
+    // File input is played as-is at every sample rate in the matrix.
+    juce::AudioBuffer<float> fileInput;
+    juce::String inputName = args.getValueForOption("--signal");
+    if (inputName.isEmpty())
+        inputName = "noise";
+
+    const auto inputPath = args.getValueForOption("--input");
+    if (inputPath.isNotEmpty())
+    {
+        const juce::File inputFile = juce::File::getCurrentWorkingDirectory().getChildFile(inputPath);
+        fileInput = RippleBench::loadInputFile(inputFile, numChannels);
+        if (fileInput.getNumSamples() == 0)
+        {
+            std::cerr << "Could not read input file: " << inputFile.getFullPathName() << std::endl;
+            return 1;
+        }
+        inputName = inputFile.getFileName();
+    }
+    else if (!RippleBench::getSyntheticInputNames().contains(inputName))
+    {
+        std::cerr << "Unknown signal '" << inputName << "', expected one of: "
+                  << RippleBench::getSyntheticInputNames().joinIntoString(", ") << std::endl;
+        return 1;
+    }
+
+    juce::Array<juce::var> results;
+
+    for (auto target : targets)
+    {
+        for (int sampleRate : sampleRates)
+        {
+            const auto input = fileInput.getNumSamples() > 0
+                                   ? fileInput
+                                   : RippleBench::makeSyntheticInput(inputName, sampleRate, numChannels, sampleRate * 4);
+
+            for (int blockSize : blockSizes)
+            {
+                for (const auto& effects : RippleBench::getEffectMatrix())
+                {
+                    RippleBench::BenchConfig config;
+                    config.target = target;
+                    config.sampleRate = sampleRate;
+                    config.blockSize = blockSize;
+                    config.numChannels = numChannels;
+                    config.seconds = seconds;
+                    config.fftOrder = fftOrder;
+                    config.overlap = overlap;
+                    config.pipelined = pipelined;
+                    config.effects = effects;
+
+                    const auto result = RippleBench::run(config, input, inputName);
+                    results.add(RippleBench::toVar(result));
+
+                    std::cerr << (target == RippleBench::Target::spectralProcessor ? "spectral " : "processor ")
+                              << sampleRate << " Hz, block " << blockSize << ", " << effects.name
+                              << ": " << juce::String(result.nsPerSample, 2) << " ns/sample, worst "
+                              << juce::String(result.worstBlockNs / 1000.0, 1) << " us" << std::endl;
+                }
+            }
+        }
+    }
+
+    juce::DynamicObject::Ptr report = new juce::DynamicObject();
+    report->setProperty("benchmark", "RippleBench");
+    report->setProperty("cpu", juce::SystemStats::getCpuModel());
+    report->setProperty("numCpus", juce::SystemStats::getNumCpus());
+    report->setProperty("secondsPerRun", seconds);
+    report->setProperty("results", results);
+
+    if (args.containsOption("--state"))
+    {
+        const int iterations = args.getValueForOption("--state").getIntValue();
+        const auto state = RippleBench::runState(iterations > 0 ? iterations : (quick ? 100 : 1000));
+        report->setProperty("state", RippleBench::toVar(state));
+
+        std::cerr << "state: save " << juce::String(state.saveNs / 1000.0, 1) << " us, recall "
+                  << juce::String(state.recallNs / 1000.0, 1) << " us, " << state.binaryBytes << " bytes; xml save "
+                  << juce::String(state.xmlSaveNs / 1000.0, 1) << " us, recall "
+                  << juce::String(state.xmlRecallNs / 1000.0, 1) << " us, " << state.xmlBytes << " bytes" << std::endl;
+    }
+
+    const auto json = juce::JSON::toString(juce::var(report.get()));
+
+    const auto outputPath = args.getValueForOption("--output");
+    if (outputPath.isNotEmpty())
+    {
+        const juce::File outputFile = juce::File::getCurrentWorkingDirectory().getChildFile(outputPath);
+        if (!outputFile.replaceWithText(json))
+        {
+            std::cerr << "Could not write " << outputFile.getFullPathName() << std::endl;
+            return 1;
+        }
+    }
+    else
+    {
+        std::cout << json << std::endl;
+    }
+
+    return 0;
+}
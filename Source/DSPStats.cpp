@@ -0,0 +1,135 @@
+/*
+  ==============================================================================
+    RIPPLE - DSP Stats Implementation
+  ==============================================================================
+*/
+
+#include "DSPStats.h"
+#include <cmath>
+
+namespace
+{
+    // Time constant of the smoothed load the meter shows
+    constexpr double loadSmoothingSeconds = 0.3;
+
+    // One writer, so a plain load and store is enough to count
+    void increment(std::atomic<juce::int64>& counter, juce::int64 amount)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+}
+
+DSPStats::DSPStats()
+    : ticksPerSecond(static_cast<double>(juce::Time::getHighResolutionTicksPerSecond()))
+{
+}
+
+void DSPStats::prepare(double newSampleRate)
+{
+    sampleRate = newSampleRate;
+    reset();
+}
+
+void DSPStats::reset()
+{
+    smoothedLoad = 0.0f;
+    smoothingBlockSize = 0;
+    worstLoad = 0.0f;
+    maxFrames = 0;
+
+    publishedLoad.store(0.0f);
+    peakLoad.store(0.0f);
+    publishedWorst.store(0.0f);
+    publishedMaxFrames.store(0);
+    totalBlocks.store(0);
+    totalFrames.store(0);
+    totalTicks.store(0);
+
+    for (auto& bucket : histogram)
+        bucket.store(0);
+
+    lastBlocks = 0;
+    lastFrames = 0;
+    lastTicks = 0;
+    lastMeanBlockMs = 0.0;
+    lastFramesPerBlock = 0.0;
+}
+
+void DSPStats::record(juce::int64 startTicks, juce::int64 endTicks, int numSamples, int numFrames)
+{
+    if (numSamples <= 0)
+        return;
+
+    const juce::int64 elapsed = endTicks - startTicks;
+    const double budgetTicks = numSamples / sampleRate * ticksPerSecond;
+    const auto load = static_cast<float>(static_cast<double>(elapsed) / budgetTicks);
+
+    // Hosts mostly keep the block size, so the coefficient rarely changes
+    if (numSamples != smoothingBlockSize)
+    {
+        smoothingBlockSize = numSamples;
+        smoothingCoeff = static_cast<float>(1.0 - std::exp(-numSamples / (sampleRate * loadSmoothingSeconds)));
+    }
+
+    smoothedLoad += (load - smoothedLoad) * smoothingCoeff;
+    publishedLoad.store(smoothedLoad, std::memory_order_relaxed);
+
+    // The reader may take the peak in between: then this block is the new one
+    if (load > peakLoad.load(std::memory_order_relaxed))
+        peakLoad.store(load, std::memory_order_relaxed);
+
+    if (load > worstLoad)
+    {
+        worstLoad = load;
+        publishedWorst.store(load, std::memory_order_relaxed);
+    }
+
+    if (numFrames > maxFrames)
+    {
+        maxFrames = numFrames;
+        publishedMaxFrames.store(numFrames, std::memory_order_relaxed);
+    }
+
+    const int bucket = juce::jlimit(0, NUM_BUCKETS - 1, static_cast<int>(load * (NUM_BUCKETS - 1)));
+    increment(histogram[static_cast<size_t>(bucket)], 1);
+
+    increment(totalFrames, numFrames);
+    increment(totalTicks, elapsed);
+
+    // Last, so a reader that sees the block also sees its time
+    totalBlocks.store(totalBlocks.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+DSPStats::Snapshot DSPStats::read()
+{
+    Snapshot snapshot;
+
+    snapshot.numBlocks = totalBlocks.load(std::memory_order_acquire);
+    snapshot.numFrames = totalFrames.load(std::memory_order_relaxed);
+    const juce::int64 ticks = totalTicks.load(std::memory_order_relaxed);
+
+    snapshot.load = publishedLoad.load(std::memory_order_relaxed);
+    snapshot.peakLoad = peakLoad.exchange(0.0f, std::memory_order_relaxed);
+    snapshot.worstLoad = publishedWorst.load(std::memory_order_relaxed);
+    snapshot.maxFramesPerBlock = publishedMaxFrames.load(std::memory_order_relaxed);
+    snapshot.totalSeconds = static_cast<double>(ticks) / ticksPerSecond;
+
+    for (int i = 0; i < NUM_BUCKETS; ++i)
+        snapshot.histogram[static_cast<size_t>(i)] = histogram[static_cast<size_t>(i)].load(std::memory_order_relaxed);
+
+    // Means over the blocks since the previous read, held while none arrive
+    const juce::int64 newBlocks = snapshot.numBlocks - lastBlocks;
+    if (newBlocks > 0)
+    {
+        lastMeanBlockMs = static_cast<double>(ticks - lastTicks) * 1000.0 / ticksPerSecond / static_cast<double>(newBlocks);
+        lastFramesPerBlock = static_cast<double>(snapshot.numFrames - lastFrames) / static_cast<double>(newBlocks);
+
+        lastBlocks = snapshot.numBlocks;
+        lastFrames = snapshot.numFrames;
+        lastTicks = ticks;
+    }
+
+    snapshot.meanBlockMs = lastMeanBlockMs;
+    snapshot.framesPerBlock = lastFramesPerBlock;
+    return snapshot;
+}
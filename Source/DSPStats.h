@@ -0,0 +1,80 @@
+/*
+  ==============================================================================
+    RIPPLE - DSP Stats
+    Per-block timing of the audio callback against its real-time budget.
+    The audio thread records, the message thread reads; nothing locks and
+    nothing allocates.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+
+class DSPStats
+{
+public:
+    // Load histogram: 10% of the block budget per bucket, the last one
+    // counting blocks that took the whole budget or more
+    static constexpr int NUM_BUCKETS = 11;
+
+    struct Snapshot
+    {
+        float load = 0.0f;              // Smoothed fraction of the block budget
+        float peakLoad = 0.0f;          // Highest since the previous read
+        float worstLoad = 0.0f;         // Highest since reset
+        double meanBlockMs = 0.0;       // Since the previous read (held while no blocks arrive)
+        double framesPerBlock = 0.0;    // Since the previous read
+        int maxFramesPerBlock = 0;      // Since reset
+        juce::int64 numBlocks = 0;      // Since reset
+        juce::int64 numFrames = 0;
+        double totalSeconds = 0.0;
+        std::array<juce::int64, NUM_BUCKETS> histogram {};
+    };
+
+    DSPStats();
+
+    // Not while the audio thread is recording
+    void prepare(double sampleRate);
+    void reset();
+
+    // Audio thread: one processed block, timed with
+    // juce::Time::getHighResolutionTicks()
+    void record(juce::int64 startTicks, juce::int64 endTicks, int numSamples, int numFrames);
+
+    // Single reader (the message thread, or the benchmark once the audio
+    // has stopped): the peak and the per-read means restart with each call
+    Snapshot read();
+
+private:
+    const double ticksPerSecond;
+    double sampleRate = 44100.0;
+
+    // Audio thread only
+    float smoothedLoad = 0.0f;
+    float smoothingCoeff = 0.0f;
+    int smoothingBlockSize = 0;
+    float worstLoad = 0.0f;
+    int maxFrames = 0;
+
+    // Published to the reader
+    std::atomic<float> publishedLoad { 0.0f };
+    std::atomic<float> peakLoad { 0.0f };
+    std::atomic<float> publishedWorst { 0.0f };
+    std::atomic<int> publishedMaxFrames { 0 };
+    std::atomic<juce::int64> totalBlocks { 0 };
+    std::atomic<juce::int64> totalFrames { 0 };
+    std::atomic<juce::int64> totalTicks { 0 };
+    std::array<std::atomic<juce::int64>, NUM_BUCKETS> histogram {};
+
+    // Reader only: totals at the previous read
+    juce::int64 lastBlocks = 0;
+    juce::int64 lastFrames = 0;
+    juce::int64 lastTicks = 0;
+    double lastMeanBlockMs = 0.0;
+    double lastFramesPerBlock = 0.0;
+
+    JUCE_DECLARE_NON_COPYABLE(DSPStats)
+};
@@ -0,0 +1,272 @@
+/*
+  ==============================================================================
+    RIPPLE - FDN Reverb Implementation
+  ==============================================================================
+*/
+
+#include "FDNReverb.h"
+#include "SimdOps.h"
+#include <cmath>
+
+namespace
+{
+    // Mutually prime-ish line lengths, spread so the modes don't bunch up
+    constexpr std::array<double, FDNReverb::NUM_LINES> delayTimesMs { 29.7, 37.1, 41.1, 43.7,
+                                                                     53.3, 59.9, 67.7, 79.3 };
+
+    // Below this the input and tail count as silence
+    constexpr float silenceThreshold = 1.0e-6f;
+}
+
+void FDNReverb::prepare(double newSampleRate, int newNumChannels)
+{
+    sampleRate = newSampleRate;
+    numChannels = juce::jlimit(1, 2, newNumChannels);
+
+    longestDelay = 0;
+    for (int line = 0; line < NUM_LINES; ++line)
+    {
+        delayLength[line] = juce::jmax(1, juce::roundToInt(delayTimesMs[line] * 0.001 * sampleRate));
+        longestDelay = juce::jmax(longestDelay, delayLength[line]);
+    }
+
+    const int numFrames = juce::nextPowerOfTwo(longestDelay + 1);
+    delayMemory.assign(static_cast<size_t>(numFrames) * NUM_LINES, 0.0f);
+    delayMask = numFrames - 1;
+
+    // Left feeds and taps the even lines, right the odd ones, with
+    // alternating signs; the matrix spreads both across every line
+    for (int line = 0; line < NUM_LINES; ++line)
+    {
+        const float sign = (line / 2) % 2 == 0 ? 1.0f : -1.0f;
+        const bool even = line % 2 == 0;
+
+        injectLeft[line] = even ? sign * 0.5f : 0.0f;
+        injectRight[line] = even ? 0.0f : sign * 0.5f;
+        tapLeft[line] = even ? sign * 0.35f : 0.0f;
+        tapRight[line] = even ? 0.0f : sign * 0.35f;
+    }
+
+    // Normalised Hadamard: orthogonal, so the decay gains alone set the RT60
+    const float scale = 1.0f / std::sqrt(static_cast<float>(NUM_LINES));
+    for (int j = 0; j < NUM_LINES; ++j)
+        for (int i = 0; i < NUM_LINES; ++i)
+            mixColumns[j][i] = (juce::countNumberOfBits(static_cast<uint32_t>(i & j)) % 2 == 0) ? scale : -scale;
+
+    wetMix.reset(sampleRate, 0.05);
+    coefficientSize = -1.0f;
+    coefficientDamping = -1.0f;
+    reset();
+}
+
+void FDNReverb::reset()
+{
+    clearNetwork();
+    wetMix.setCurrentAndTargetValue(0.0f);
+    running = false;
+}
+
+void FDNReverb::clearNetwork()
+{
+    std::fill(delayMemory.begin(), delayMemory.end(), 0.0f);
+    lowpassState.fill(0.0f);
+    writePosition = 0;
+    silentSamples = 0;
+    networkDirty = false;
+}
+
+double FDNReverb::getDecaySeconds(float sizeAmount)
+{
+    // Size sweeps the RT60 exponentially
+    return MIN_DECAY_SECONDS * std::pow(MAX_DECAY_SECONDS / MIN_DECAY_SECONDS, juce::jlimit(0.0f, 1.0f, sizeAmount));
+}
+
+void FDNReverb::updateCoefficients(float newSize, float newDamping)
+{
+    if (newSize == coefficientSize && newDamping == coefficientDamping)
+        return;
+
+    coefficientSize = newSize;
+    coefficientDamping = newDamping;
+
+    // Each line loses 60 dB over the RT60
+    const double decaySeconds = getDecaySeconds(newSize);
+    for (int line = 0; line < NUM_LINES; ++line)
+        decayGain[line] = static_cast<float>(std::pow(10.0, -3.0 * delayLength[line] / (decaySeconds * sampleRate)));
+
+    dampingCoefficient = juce::jlimit(0.0f, 1.0f, newDamping) * 0.85f;
+}
+
+template <typename Ops>
+void FDNReverb::processNetwork(const float* inputLeft, const float* inputRight, float* outputLeft, float* outputRight,
+                               int numSamples)
+{
+    using V = typename Ops::V;
+    static_assert(NUM_LINES % Ops::width == 0, "The lines must fill whole vectors");
+    constexpr int numVectors = NUM_LINES / Ops::width;
+
+    const V damp = Ops::set(dampingCoefficient);
+    V lowpass[numVectors], gain[numVectors], injectL[numVectors], injectR[numVectors], tapL[numVectors], tapR[numVectors];
+
+    for (int v = 0; v < numVectors; ++v)
+    {
+        const int lane = v * Ops::width;
+        lowpass[v] = Ops::load(lowpassState.data() + lane);
+        gain[v] = Ops::load(decayGain.data() + lane);
+        injectL[v] = Ops::load(injectLeft.data() + lane);
+        injectR[v] = Ops::load(injectRight.data() + lane);
+        tapL[v] = Ops::load(tapLeft.data() + lane);
+        tapR[v] = Ops::load(tapRight.data() + lane);
+    }
+
+    alignas(32) std::array<float, NUM_LINES> lineOutput;
+    float* memory = delayMemory.data();
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // Each line read at its own length behind the write position
+        for (int line = 0; line < NUM_LINES; ++line)
+            lineOutput[line] = memory[((writePosition - delayLength[line]) & delayMask) * NUM_LINES + line];
+
+        // Damping and decay, then the output taps
+        V sumL = Ops::set(0.0f);
+        V sumR = Ops::set(0.0f);
+
+        for (int v = 0; v < numVectors; ++v)
+        {
+            float* lanes = lineOutput.data() + v * Ops::width;
+            const V raw = Ops::load(lanes);
+            lowpass[v] = Ops::add(raw, Ops::mul(damp, Ops::sub(lowpass[v], raw)));
+
+            const V decayed = Ops::mul(lowpass[v], gain[v]);
+            Ops::store(lanes, decayed);
+
+            sumL = Ops::add(sumL, Ops::mul(decayed, tapL[v]));
+            sumR = Ops::add(sumR, Ops::mul(decayed, tapR[v]));
+        }
+
+        outputLeft[i] = Ops::sum(sumL);
+        outputRight[i] = Ops::sum(sumR);
+
+        // Mix through the matrix, add the input and write the frame back
+        float* frame = memory + writePosition * NUM_LINES;
+        const V left = Ops::set(inputLeft[i]);
+        const V right = Ops::set(inputRight[i]);
+
+        for (int v = 0; v < numVectors; ++v)
+        {
+            const int lane = v * Ops::width;
+            V feedback = Ops::add(Ops::mul(left, injectL[v]), Ops::mul(right, injectR[v]));
+
+            for (int j = 0; j < NUM_LINES; ++j)
+                feedback = Ops::add(feedback, Ops::mul(Ops::set(lineOutput[j]), Ops::load(mixColumns[j].data() + lane)));
+
+            Ops::store(frame + lane, feedback);
+        }
+
+        writePosition = (writePosition + 1) & delayMask;
+    }
+
+    for (int v = 0; v < numVectors; ++v)
+        Ops::store(lowpassState.data() + v * Ops::width, lowpass[v]);
+}
+
+void FDNReverb::process(juce::AudioBuffer<float>& buffer)
+{
+    wetMix.setTargetValue(enabled.load() ? juce::jlimit(0.0f, 1.0f, mix.load()) : 0.0f);
+
+    // Disabled or at zero mix once the fade has finished: nothing to do. The
+    // tail left in the lines is cleared when the reverb comes back.
+    if (!wetMix.isSmoothing() && wetMix.getTargetValue() <= 0.0f)
+    {
+        if (running)
+            networkDirty = true;
+
+        running = false;
+        return;
+    }
+
+    const int numSamples = buffer.getNumSamples();
+    const int channelsToProcess = juce::jmin(numChannels, buffer.getNumChannels());
+    if (channelsToProcess == 0 || numSamples == 0)
+        return;
+
+    float* left = buffer.getWritePointer(0);
+    float* right = channelsToProcess > 1 ? buffer.getWritePointer(1) : nullptr;
+
+    float inputPeak = buffer.getMagnitude(0, 0, numSamples);
+    if (right != nullptr)
+        inputPeak = juce::jmax(inputPeak, buffer.getMagnitude(1, 0, numSamples));
+
+    // Decayed: the wet signal is silent until the input comes back, so only
+    // the dry gain is left to apply
+    if (!running)
+    {
+        if (inputPeak < silenceThreshold)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const float dryGain = 1.0f - wetMix.getNextValue();
+                left[i] *= dryGain;
+                if (right != nullptr)
+                    right[i] *= dryGain;
+            }
+            return;
+        }
+
+        if (networkDirty)
+            clearNetwork();
+
+        running = true;
+        silentSamples = 0;
+    }
+
+    updateCoefficients(size.load(), damping.load());
+
+    float wetPeak = 0.0f;
+
+    for (int position = 0; position < numSamples; position += CHUNK_SIZE)
+    {
+        const int chunk = juce::jmin(CHUNK_SIZE, numSamples - position);
+        float* chunkLeft = left + position;
+        float* chunkRight = right != nullptr ? right + position : chunkLeft;
+
+        processNetwork<SimdOps::VectorOps>(chunkLeft, chunkRight, wetLeft.data(), wetRight.data(), chunk);
+
+        if (right == nullptr)
+        {
+            for (int i = 0; i < chunk; ++i)
+                wetLeft[i] = 0.5f * (wetLeft[i] + wetRight[i]);
+        }
+
+        for (int i = 0; i < chunk; ++i)
+        {
+            const float wetGain = wetMix.getNextValue();
+            chunkLeft[i] += wetGain * (wetLeft[i] - chunkLeft[i]);
+            if (right != nullptr)
+                chunkRight[i] += wetGain * (wetRight[i] - chunkRight[i]);
+        }
+
+        const auto leftRange = juce::FloatVectorOperations::findMinAndMax(wetLeft.data(), chunk);
+        wetPeak = juce::jmax(wetPeak, -leftRange.getStart(), leftRange.getEnd());
+
+        if (right != nullptr)
+        {
+            const auto rightRange = juce::FloatVectorOperations::findMinAndMax(wetRight.data(), chunk);
+            wetPeak = juce::jmax(wetPeak, -rightRange.getStart(), rightRange.getEnd());
+        }
+    }
+
+    // Tail detection: once input and output have stayed silent for longer
+    // than the longest line, whatever is left in the network is inaudible
+    if (inputPeak < silenceThreshold && wetPeak < silenceThreshold)
+        silentSamples += numSamples;
+    else
+        silentSamples = 0;
+
+    if (silentSamples > longestDelay)
+    {
+        clearNetwork();
+        running = false;
+    }
+}
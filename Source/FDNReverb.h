@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+    RIPPLE - FDN Reverb
+    Eight-line feedback delay network for the reverb_* parameters. The lines
+    run side by side in SIMD lanes: one-pole damping, decay gains and an
+    orthogonal (Hadamard) mixing matrix, with the delay memory interleaved so
+    each sample's write-back is a vector store.
+
+    Costs nothing while disabled or at zero mix, and stops running the
+    network once its tail has decayed and the input is silent.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include <array>
+#include <atomic>
+#include <vector>
+
+class FDNReverb
+{
+public:
+    static constexpr int NUM_LINES = 8;
+    static constexpr float MIN_DECAY_SECONDS = 0.3f;
+    static constexpr float MAX_DECAY_SECONDS = 8.0f;
+
+    void prepare(double sampleRate, int numChannels);
+    void reset();
+
+    // Processes in place: out = (1 - mix) * dry + mix * wet
+    void process(juce::AudioBuffer<float>& buffer);
+
+    // Control parameters
+    void setEnabled(bool shouldBeEnabled) { enabled.store(shouldBeEnabled); }
+    void setSize(float amount) { size.store(amount); }          // 0 to 1, decay time
+    void setDamping(float amount) { damping.store(amount); }    // 0 to 1, high-frequency loss
+    void setMix(float amount) { mix.store(amount); }            // 0 to 1
+
+    // RT60 for a size amount: MIN_DECAY_SECONDS at 0, MAX_DECAY_SECONDS at 1
+    static double getDecaySeconds(float sizeAmount);
+
+    // True while the network is running (not bypassed or decayed)
+    bool isActive() const { return running; }
+
+private:
+    void updateCoefficients(float newSize, float newDamping);
+    void clearNetwork();
+
+    template <typename Ops>
+    void processNetwork(const float* inputLeft, const float* inputRight, float* outputLeft, float* outputRight,
+                        int numSamples);
+
+    double sampleRate = 44100.0;
+    int numChannels = 2;
+
+    // Interleaved delay memory: frame p holds one sample per line at
+    // [p * NUM_LINES, (p + 1) * NUM_LINES). Power-of-two frames, one mask.
+    std::vector<float> delayMemory;
+    int delayMask = 0;
+    int writePosition = 0;
+    std::array<int, NUM_LINES> delayLength {};
+    int longestDelay = 0;
+
+    // Per line, in lanes
+    alignas(32) std::array<float, NUM_LINES> decayGain {};
+    alignas(32) std::array<float, NUM_LINES> lowpassState {};
+    alignas(32) std::array<float, NUM_LINES> injectLeft {};
+    alignas(32) std::array<float, NUM_LINES> injectRight {};
+    alignas(32) std::array<float, NUM_LINES> tapLeft {};
+    alignas(32) std::array<float, NUM_LINES> tapRight {};
+
+    // Mixing matrix, column j = the contribution of line j to every line
+    alignas(32) std::array<std::array<float, NUM_LINES>, NUM_LINES> mixColumns {};
+
+    float dampingCoefficient = 0.0f;
+    float coefficientSize = -1.0f;      // -1 = needs rebuilding
+    float coefficientDamping = -1.0f;
+
+    // Wet output, worked out in chunks of up to CHUNK_SIZE samples
+    static constexpr int CHUNK_SIZE = 256;
+    std::array<float, CHUNK_SIZE> wetLeft {};
+    std::array<float, CHUNK_SIZE> wetRight {};
+
+    juce::SmoothedValue<float> wetMix;
+
+    // Bypass and tail state
+    bool running = false;
+    bool networkDirty = false;          // Delay memory holds a tail that must go before reuse
+    int silentSamples = 0;
+
+    // Parameters
+    std::atomic<bool> enabled { false };
+    std::atomic<float> size { 0.5f };
+    std::atomic<float> damping { 0.5f };
+    std::atomic<float> mix { 0.3f };
+};
@@ -0,0 +1,245 @@
+/*
+  ==============================================================================
+    RIPPLE - Frame Pool Implementation
+  ==============================================================================
+*/
+
+#include "FramePool.h"
+#include "SpectralProcessor.h"
+#include <thread>
+
+#if JUCE_WINDOWS
+ #include <windows.h>
+#elif JUCE_MAC || JUCE_IOS
+ #include <dispatch/dispatch.h>
+#else
+ #include <semaphore.h>
+ #include <cerrno>
+ #include <ctime>
+#endif
+
+//==============================================================================
+#if JUCE_WINDOWS
+struct FramePool::Semaphore::Native
+{
+    HANDLE handle = CreateSemaphoreW(nullptr, 0, MAXLONG, nullptr);
+    ~Native() { CloseHandle(handle); }
+};
+
+void FramePool::Semaphore::post() { ReleaseSemaphore(native->handle, 1, nullptr); }
+void FramePool::Semaphore::wait(int timeoutMs) { WaitForSingleObject(native->handle, static_cast<DWORD>(timeoutMs)); }
+
+#elif JUCE_MAC || JUCE_IOS
+struct FramePool::Semaphore::Native
+{
+    dispatch_semaphore_t handle = dispatch_semaphore_create(0);
+    ~Native() { dispatch_release(handle); }
+};
+
+void FramePool::Semaphore::post() { dispatch_semaphore_signal(native->handle); }
+
+void FramePool::Semaphore::wait(int timeoutMs)
+{
+    dispatch_semaphore_wait(native->handle, dispatch_time(DISPATCH_TIME_NOW, static_cast<int64_t>(timeoutMs) * NSEC_PER_MSEC));
+}
+
+#else
+// Only makes a system call when a worker is asleep on it
+struct FramePool::Semaphore::Native
+{
+    sem_t handle;
+    Native() { sem_init(&handle, 0, 0); }
+    ~Native() { sem_destroy(&handle); }
+};
+
+void FramePool::Semaphore::post() { sem_post(&native->handle); }
+
+void FramePool::Semaphore::wait(int timeoutMs)
+{
+    timespec until;
+    clock_gettime(CLOCK_REALTIME, &until);
+    until.tv_sec += timeoutMs / 1000;
+    until.tv_nsec += static_cast<long>(timeoutMs % 1000) * 1000000L;
+    if (until.tv_nsec >= 1000000000L)
+    {
+        ++until.tv_sec;
+        until.tv_nsec -= 1000000000L;
+    }
+
+    while (sem_timedwait(&native->handle, &until) != 0 && errno == EINTR) {}
+}
+#endif
+
+FramePool::Semaphore::Semaphore() : native(std::make_unique<Native>()) {}
+FramePool::Semaphore::~Semaphore() = default;
+
+//==============================================================================
+
+class FramePool::Worker : public juce::Thread
+{
+public:
+    Worker(FramePool& owner, int index)
+        : juce::Thread("Ripple Frame Pool " + juce::String(index + 1)), pool(owner), workerIndex(index)
+    {
+    }
+
+    ~Worker() override
+    {
+        stopThread(1000);
+    }
+
+    void run() override
+    {
+        juce::ScopedNoDenormals noDenormals;
+
+        while (!threadShouldExit())
+        {
+            // Sleeps until a processor queues frames, with a timeout as a backstop
+            if (!pool.runNext(workerIndex))
+                pool.wakeSignal.wait(100);
+        }
+    }
+
+private:
+    FramePool& pool;
+    const int workerIndex;
+};
+
+FramePool::FramePool()
+{
+    // Leave a core to the host's own audio thread
+    const int numWorkers = juce::jlimit(1, MAX_WORKERS, juce::SystemStats::getNumCpus() - 1);
+
+    for (int i = 0; i < numWorkers; ++i)
+    {
+        workers.push_back(std::make_unique<Worker>(*this, i));
+
+        if (!workers.back()->startRealtimeThread(juce::Thread::RealtimeOptions {}))
+            workers.back()->startThread(juce::Thread::Priority::highest);
+    }
+}
+
+FramePool::~FramePool()
+{
+    for (auto& worker : workers)
+        worker->signalThreadShouldExit();
+
+    // Each post wakes one sleeping worker, which then sees the exit flag
+    for (auto& worker : workers)
+    {
+        while (worker->isThreadRunning())
+        {
+            wakeSignal.post();
+            worker->waitForThreadToExit(1);
+        }
+    }
+
+    workers.clear();
+}
+
+std::shared_ptr<FramePool> FramePool::getInstance()
+{
+    // Weak, so the threads go when the last processor does rather than at
+    // static destruction, which a plugin unload may never reach cleanly
+    static std::mutex instanceLock;
+    static std::weak_ptr<FramePool> instance;
+
+    const std::lock_guard<std::mutex> lock(instanceLock);
+
+    auto pool = instance.lock();
+    if (pool == nullptr)
+    {
+        pool.reset(new FramePool());
+        instance = pool;
+    }
+
+    return pool;
+}
+
+FramePool::Entry* FramePool::add(SpectralProcessor& processor)
+{
+    const std::lock_guard<std::mutex> lock(registryLock);
+
+    for (int i = 0; i < MAX_ENTRIES; ++i)
+    {
+        auto& entry = entries[static_cast<size_t>(i)];
+        if (entry.processor.load() != nullptr || entry.busy.load())
+            continue;
+
+        entry.deadline.store(noDeadline);
+        entry.processor.store(&processor);
+
+        if (i >= numEntries.load())
+            numEntries.store(i + 1);
+
+        return &entry;
+    }
+
+    return nullptr;
+}
+
+void FramePool::remove(Entry* entry)
+{
+    if (entry == nullptr)
+        return;
+
+    const std::lock_guard<std::mutex> lock(registryLock);
+
+    // A worker claims an entry before reading its processor, so once the
+    // processor is cleared, the only one that can still hold it is one
+    // that's already busy with it
+    entry->processor.store(nullptr);
+    entry->deadline.store(noDeadline);
+
+    while (entry->busy.load())
+        std::this_thread::yield();
+}
+
+bool FramePool::runNext(int workerIndex)
+{
+    const int count = numEntries.load(std::memory_order_acquire);
+    const int numWorkers = getNumWorkers();
+
+    // Nearest deadline among this worker's own entries, anyone's if none of
+    // its own are pending
+    Entry* next = nullptr;
+    juce::int64 nextDeadline = noDeadline;
+    bool nextIsOwn = false;
+    int numPending = 0;
+
+    for (int i = 0; i < count; ++i)
+    {
+        auto& entry = entries[static_cast<size_t>(i)];
+        const juce::int64 deadline = entry.deadline.load(std::memory_order_relaxed);
+
+        if (deadline == noDeadline || entry.busy.load(std::memory_order_relaxed))
+            continue;
+
+        ++numPending;
+        const bool own = i % numWorkers == workerIndex;
+
+        if (next == nullptr || (own && !nextIsOwn) || (own == nextIsOwn && deadline < nextDeadline))
+        {
+            next = &entry;
+            nextDeadline = deadline;
+            nextIsOwn = own;
+        }
+    }
+
+    if (next == nullptr)
+        return false;
+
+    // More work than this worker is about to take: bring in another
+    if (numPending > 1)
+        wakeSignal.post();
+
+    bool expected = false;
+    if (!next->busy.compare_exchange_strong(expected, true))
+        return true;   // Another worker got there first; look again
+
+    if (auto* processor = next->processor.load())
+        processor->runQueuedFrames();
+
+    next->busy.store(false);
+    return true;
+}
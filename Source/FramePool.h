@@ -0,0 +1,95 @@
+/*
+  ==============================================================================
+    RIPPLE - Frame Pool
+    Process-wide worker threads for pipelined SpectralProcessors. Every
+    processor in pipelined mode registers an entry; its audio thread queues
+    frames and publishes the deadline of the oldest one, and the workers
+    run them.
+
+    A processor's frames have to run in order, so the unit of work is a
+    processor's queue rather than a single frame. Each worker looks after
+    every Nth entry and runs the nearest deadline among those first. With
+    none of its own pending it steals the nearest one anyone has. An entry
+    is only ever run by one worker at a time.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class SpectralProcessor;
+
+class FramePool
+{
+public:
+    static constexpr int MAX_ENTRIES = 1024;
+    static constexpr int MAX_WORKERS = 8;
+    static constexpr juce::int64 noDeadline = std::numeric_limits<juce::int64>::max();
+
+    // A line each: every entry is written by its own processor's audio thread
+    struct alignas(64) Entry
+    {
+        std::atomic<SpectralProcessor*> processor { nullptr };
+        std::atomic<juce::int64> deadline { noDeadline };   // High-resolution ticks, noDeadline = idle
+        std::atomic<bool> busy { false };                   // A worker is running it
+    };
+
+    ~FramePool();
+
+    // Shared by every processor in the process: created on first use and
+    // shut down with its last user. Not for the audio thread.
+    static std::shared_ptr<FramePool> getInstance();
+
+    // Registers a processor; nullptr if the pool is full, in which case its
+    // frames run on its own audio thread when they fall due. remove() waits
+    // for a worker in the middle of the processor's frames.
+    Entry* add(SpectralProcessor& processor);
+    void remove(Entry* entry);
+
+    // Audio thread: a processor queued frames
+    void notify() { wakeSignal.post(); }
+
+    int getNumWorkers() const { return static_cast<int>(workers.size()); }
+
+private:
+    FramePool();
+
+    class Worker;
+
+    // Counting semaphore. Unlike juce::WaitableEvent, posting never takes a
+    // lock, so the audio thread can wake a worker without waiting on one.
+    class Semaphore
+    {
+    public:
+        Semaphore();
+        ~Semaphore();
+
+        void post();
+        void wait(int timeoutMs);
+
+    private:
+        struct Native;
+        std::unique_ptr<Native> native;
+
+        JUCE_DECLARE_NON_COPYABLE(Semaphore)
+    };
+
+    // Runs one processor's pending frames. False if none had any.
+    bool runNext(int workerIndex);
+
+    std::array<Entry, MAX_ENTRIES> entries;
+    std::atomic<int> numEntries { 0 };   // Entries in use lie below this
+    std::mutex registryLock;             // add() and remove() only
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    Semaphore wakeSignal;
+
+    JUCE_DECLARE_NON_COPYABLE(FramePool)
+};
@@ -0,0 +1,153 @@
+/*
+  ==============================================================================
+    RIPPLE - Modulation Engine Implementation
+  ==============================================================================
+*/
+
+#include "ModulationEngine.h"
+#include "SpectralKernels.h"
+#include <cmath>
+
+ModulationEngine::ModulationEngine(juce::AudioProcessorValueTreeState& apvts)
+{
+    for (int i = 0; i < NUM_LFOS; ++i)
+    {
+        lfoParameters[i].rate = apvts.getRawParameterValue(rateIDs[i]);
+        lfoParameters[i].shape = apvts.getRawParameterValue(shapeIDs[i]);
+        lfoParameters[i].phase = apvts.getRawParameterValue(phaseIDs[i]);
+    }
+
+    for (int i = 0; i < NUM_SLOTS; ++i)
+    {
+        slotParameters[i].source = apvts.getRawParameterValue(sourceIDs[i]);
+        slotParameters[i].target = apvts.getRawParameterValue(targetIDs[i]);
+        slotParameters[i].depth = apvts.getRawParameterValue(depthIDs[i]);
+    }
+
+    syncParameter = apvts.getRawParameterValue(ParamIDs::lfoSync);
+    seedParameter = apvts.getRawParameterValue(ParamIDs::randomSeed);
+
+    jassert(ModTargets::targets.size() == numTargets);
+    jassert(ModSources::sources.size() == NUM_LFOS + 1);
+
+    reset();
+}
+
+void ModulationEngine::prepare(double newSampleRate)
+{
+    sampleRate = newSampleRate;
+    reset();
+}
+
+void ModulationEngine::reset()
+{
+    cycles.fill(0.0);
+    heldCycle.fill(-1.0);
+    held.fill(0.0f);
+    values.fill(0.0f);
+    offsets.fill(0.0f);
+    blockSamples = 0;
+}
+
+double ModulationEngine::snapToNoteLength(double cyclesPerBeat)
+{
+    const double exponent = std::round(std::log2(juce::jmax(cyclesPerBeat, 1.0e-6)));
+    return std::exp2(juce::jlimit(-6.0, 4.0, exponent));
+}
+
+void ModulationEngine::beginBlock(juce::AudioPlayHead* playHead)
+{
+    numRoutes = 0;
+    for (const auto& slot : slotParameters)
+    {
+        const int source = static_cast<int>(slot.source->load());
+        const int target = static_cast<int>(slot.target->load());
+        const float depth = slot.depth->load();
+
+        if (source > 0 && target > none && target < numTargets && depth != 0.0f)
+            routes[numRoutes++] = { source - 1, target, depth };
+    }
+
+    // Offsets hold between hops, so block-rate readers don't see them drop out
+    if (numRoutes == 0)
+    {
+        offsets.fill(0.0f);
+        return;
+    }
+
+    for (int i = 0; i < NUM_LFOS; ++i)
+    {
+        increments[i] = lfoParameters[i].rate->load() / sampleRate;
+        shapes[i] = lfoParameters[i].shape->load();
+        phaseOffsets[i] = lfoParameters[i].phase->load();
+    }
+
+    seed = static_cast<juce::uint32>(seedParameter->load());
+
+    // Synced LFOs follow the host position while it plays and free run otherwise
+    synced = false;
+    if (syncParameter->load() > 0.5f && playHead != nullptr)
+    {
+        const auto position = playHead->getPosition();
+        if (position.hasValue() && position->getIsPlaying())
+        {
+            const auto bpm = position->getBpm();
+            const auto ppq = position->getPpqPosition();
+
+            if (bpm.hasValue() && ppq.hasValue() && *bpm > 0.0)
+            {
+                synced = true;
+                blockPpq = *ppq;
+                ppqPerSample = *bpm / (60.0 * sampleRate);
+                blockSamples = 0;
+
+                for (int i = 0; i < NUM_LFOS; ++i)
+                    cyclesPerBeat[i] = snapToNoteLength(increments[i] * sampleRate * 60.0 / *bpm);
+            }
+        }
+    }
+}
+
+void ModulationEngine::advance(int numSamples)
+{
+    if (numRoutes == 0)
+        return;
+
+    // Synced cycles are re-anchored to the playhead every block, so they stay
+    // locked to the host to within a hop
+    if (synced)
+    {
+        blockSamples += numSamples;
+        const double ppq = blockPpq + blockSamples * ppqPerSample;
+
+        for (int i = 0; i < NUM_LFOS; ++i)
+            cycles[i] = ppq * cyclesPerBeat[i];
+    }
+    else
+    {
+        for (int i = 0; i < NUM_LFOS; ++i)
+            cycles[i] += increments[i] * numSamples;
+    }
+
+    for (int i = 0; i < NUM_LFOS; ++i)
+    {
+        const double position = cycles[i] + phaseOffsets[i];
+        const double cycle = std::floor(position);
+        phases[i] = static_cast<float>(position - cycle);
+
+        // New random step on every cycle, keyed by the cycle number, so a
+        // synced LFO plays the same steps at the same song position
+        if (cycle != heldCycle[i])
+        {
+            heldCycle[i] = cycle;
+            SpectralKernels::noise(seed + static_cast<juce::uint32>(i),
+                                   static_cast<juce::uint32>(static_cast<juce::int64>(cycle)), 1.0f, &held[i], 1);
+        }
+    }
+
+    SpectralKernels::lfoWaveforms(phases.data(), shapes.data(), held.data(), values.data(), NUM_LFOS);
+
+    offsets.fill(0.0f);
+    for (int r = 0; r < numRoutes; ++r)
+        offsets[routes[r].target] += routes[r].depth * values[routes[r].lfo];
+}
@@ -0,0 +1,148 @@
+/*
+  ==============================================================================
+    RIPPLE - Modulation Engine
+    Four LFOs and the four-slot mod matrix from ParameterIDs.h.
+    Runs at control rate: the spectral processor advances it once per STFT
+    hop, and the four LFOs are evaluated together in one vector.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "ParameterIDs.h"
+#include <array>
+
+class ModulationEngine
+{
+public:
+    static constexpr int NUM_LFOS = 4;
+    static constexpr int NUM_SLOTS = 4;
+
+    // Indices into ModTargets::targets
+    enum Target
+    {
+        none = 0,
+        rippleRate,
+        rippleMultiply,
+        rippleAmount,
+        rippleWidth,
+        rippleLowBypass,
+        rippleHighBypass,
+        rippleMix,
+        reverbSize,
+        reverbDamping,
+        reverbMix,
+        freeze,
+        smear,
+        scatter,
+        shift,
+        tilt,
+        feedback,
+        numTargets
+    };
+
+    static constexpr std::array<const char*, NUM_LFOS> rateIDs { ParamIDs::lfo1Rate, ParamIDs::lfo2Rate,
+                                                                 ParamIDs::lfo3Rate, ParamIDs::lfo4Rate };
+    static constexpr std::array<const char*, NUM_LFOS> shapeIDs { ParamIDs::lfo1Shape, ParamIDs::lfo2Shape,
+                                                                  ParamIDs::lfo3Shape, ParamIDs::lfo4Shape };
+    static constexpr std::array<const char*, NUM_LFOS> phaseIDs { ParamIDs::lfo1Phase, ParamIDs::lfo2Phase,
+                                                                  ParamIDs::lfo3Phase, ParamIDs::lfo4Phase };
+    static constexpr std::array<const char*, NUM_SLOTS> sourceIDs { ParamIDs::mod1Source, ParamIDs::mod2Source,
+                                                                    ParamIDs::mod3Source, ParamIDs::mod4Source };
+    static constexpr std::array<const char*, NUM_SLOTS> targetIDs { ParamIDs::mod1Target, ParamIDs::mod2Target,
+                                                                    ParamIDs::mod3Target, ParamIDs::mod4Target };
+    static constexpr std::array<const char*, NUM_SLOTS> depthIDs { ParamIDs::mod1Depth, ParamIDs::mod2Depth,
+                                                                   ParamIDs::mod3Depth, ParamIDs::mod4Depth };
+
+    // Looks the parameters up once; the audio thread only reads the cached pointers
+    explicit ModulationEngine(juce::AudioProcessorValueTreeState& apvts);
+
+    void prepare(double sampleRate);
+    void reset();
+
+    // Once per block, before processing: reads the parameters and, with
+    // sync on, the host tempo and position
+    void beginBlock(juce::AudioPlayHead* playHead);
+
+    // Steps the LFOs by numSamples and resolves the slots. Called once per hop.
+    void advance(int numSamples);
+
+    // True if any slot routes an LFO to a target
+    bool isActive() const { return numRoutes > 0; }
+
+    // Sum of depth * LFO over the slots on a target, in units of its full range
+    float getOffset(Target target) const { return offsets[target]; }
+
+    // base moved by the target's offset, clamped to [minValue, maxValue]
+    float apply(Target target, float base, float minValue, float maxValue) const
+    {
+        return juce::jlimit(minValue, maxValue, base + offsets[target] * (maxValue - minValue));
+    }
+
+    // A parameter's value moved by the target's offset in normalised units,
+    // so skewed ranges are swept the way their controls move
+    float apply(Target target, const juce::RangedAudioParameter& parameter) const
+    {
+        return parameter.convertFrom0to1(juce::jlimit(0.0f, 1.0f, parameter.getValue() + offsets[target]));
+    }
+
+private:
+    // Synced rates snap to power-of-two note lengths, 16 bars down to 1/64
+    static double snapToNoteLength(double cyclesPerBeat);
+
+    struct LFOParameters
+    {
+        std::atomic<float>* rate = nullptr;
+        std::atomic<float>* shape = nullptr;
+        std::atomic<float>* phase = nullptr;
+    };
+
+    struct SlotParameters
+    {
+        std::atomic<float>* source = nullptr;
+        std::atomic<float>* target = nullptr;
+        std::atomic<float>* depth = nullptr;
+    };
+
+    std::array<LFOParameters, NUM_LFOS> lfoParameters;
+    std::array<SlotParameters, NUM_SLOTS> slotParameters;
+    std::atomic<float>* syncParameter = nullptr;
+    std::atomic<float>* seedParameter = nullptr;
+
+    double sampleRate = 44100.0;
+
+    // Resolved once per block
+    struct Route
+    {
+        int lfo = 0;
+        int target = none;
+        float depth = 0.0f;
+    };
+
+    std::array<Route, NUM_SLOTS> routes;
+    int numRoutes = 0;
+
+    std::array<double, NUM_LFOS> increments {};     // Free running, cycles per sample
+    std::array<double, NUM_LFOS> cyclesPerBeat {};  // Synced
+    std::array<double, NUM_LFOS> phaseOffsets {};
+    bool synced = false;
+    double blockPpq = 0.0;
+    double ppqPerSample = 0.0;
+    int blockSamples = 0;
+
+    // Cycles run since reset; the whole part picks the sample-and-hold value
+    std::array<double, NUM_LFOS> cycles {};
+    std::array<double, NUM_LFOS> heldCycle {};
+
+    // Kernel inputs and outputs, one lane per LFO
+    std::array<float, NUM_LFOS> phases {};
+    std::array<float, NUM_LFOS> shapes {};
+    std::array<float, NUM_LFOS> held {};
+    std::array<float, NUM_LFOS> values {};
+
+    std::array<float, numTargets> offsets {};
+
+    juce::uint32 seed = 0;
+
+    JUCE_DECLARE_NON_COPYABLE(ModulationEngine)
+};
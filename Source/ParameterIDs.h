@@ -59,6 +59,9 @@ namespace ParamIDs
     inline constexpr const char* lfo4Shape = "lfo4_shape";
     inline constexpr const char* lfo4Phase = "lfo4_phase";
 
+    // Tempo sync for all four (rates snap to note lengths at the host tempo)
+    inline constexpr const char* lfoSync = "lfo_sync";
+
     // ===========================================================================
     // Modulation Matrix (4 Slots)
     // ===========================================================================
@@ -136,6 +139,12 @@ namespace ModTargets
         "Ripple Mix",
         "Reverb Size",
         "Reverb Damping",
-        "Reverb Mix"
+        "Reverb Mix",
+        "Freeze",
+        "Sustain",
+        "Diffuse",
+        "Shift",
+        "Tilt",
+        "Feedback"
     };
 }
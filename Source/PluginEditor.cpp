@@ -5,12 +5,42 @@
 */
 
 #include "PluginEditor.h"
+#include "WebUIResources.h"
 #include <thread>
 
 #if BEATCONNECT_ACTIVATION_ENABLED
 #include <beatconnect/Activation.h>
 #endif
 
+namespace
+{
+    // Standard base64 into a caller-owned buffer of (size + 2) / 3 * 4 chars
+    void encodeBase64(const juce::uint8* data, int size, char* out)
+    {
+        static constexpr char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+        for (int i = 0; i < size; i += 3)
+        {
+            const int remaining = size - i;
+            const juce::uint32 b0 = data[i];
+            const juce::uint32 b1 = remaining > 1 ? data[i + 1] : 0u;
+            const juce::uint32 b2 = remaining > 2 ? data[i + 2] : 0u;
+            const juce::uint32 triple = (b0 << 16) | (b1 << 8) | b2;
+
+            *out++ = alphabet[(triple >> 18) & 63];
+            *out++ = alphabet[(triple >> 12) & 63];
+            *out++ = remaining > 1 ? alphabet[(triple >> 6) & 63] : '=';
+            *out++ = remaining > 2 ? alphabet[triple & 63] : '=';
+        }
+    }
+
+    void quantise(const std::array<float, SpectrumDisplay::NUM_BANDS>& bands, juce::uint8* out)
+    {
+        for (float value : bands)
+            *out++ = static_cast<juce::uint8>(juce::jlimit(0.0f, 1.0f, value) * 255.0f + 0.5f);
+    }
+}
+
 //==============================================================================
 RippleEditor::RippleEditor(RippleProcessor& p)
     : AudioProcessorEditor(&p),
@@ -44,50 +74,30 @@ void RippleEditor::setupWebView()
     tiltRelay = std::make_unique<juce::WebSliderRelay>("tilt");
     feedbackRelay = std::make_unique<juce::WebSliderRelay>("feedback");
 
-    // Get resources directory
-    auto executableFile = juce::File::getSpecialLocation(juce::File::currentExecutableFile);
-    auto executableDir = executableFile.getParentDirectory();
+    for (int i = 0; i < ModulationEngine::NUM_LFOS; ++i)
+    {
+        lfoRateRelays[i] = std::make_unique<juce::WebSliderRelay>(ModulationEngine::rateIDs[i]);
+        lfoShapeRelays[i] = std::make_unique<juce::WebComboBoxRelay>(ModulationEngine::shapeIDs[i]);
+        lfoPhaseRelays[i] = std::make_unique<juce::WebSliderRelay>(ModulationEngine::phaseIDs[i]);
+    }
+
+    lfoSyncRelay = std::make_unique<juce::WebToggleButtonRelay>(ParamIDs::lfoSync);
 
-    resourcesDir = executableDir.getChildFile("Resources").getChildFile("WebUI");
-    if (!resourcesDir.isDirectory())
-        resourcesDir = executableDir.getParentDirectory()
-                           .getChildFile("Resources")
-                           .getChildFile("WebUI");
+    for (int i = 0; i < ModulationEngine::NUM_SLOTS; ++i)
+    {
+        modSourceRelays[i] = std::make_unique<juce::WebComboBoxRelay>(ModulationEngine::sourceIDs[i]);
+        modTargetRelays[i] = std::make_unique<juce::WebComboBoxRelay>(ModulationEngine::targetIDs[i]);
+        modDepthRelays[i] = std::make_unique<juce::WebSliderRelay>(ModulationEngine::depthIDs[i]);
+    }
 
     // Build WebView
     auto options = juce::WebBrowserComponent::Options()
         .withBackend(juce::WebBrowserComponent::Options::Backend::webview2)
         .withNativeIntegrationEnabled()
         .withResourceProvider(
-            [this](const juce::String& url) -> std::optional<juce::WebBrowserComponent::Resource>
+            [](const juce::String& url)
             {
-                auto path = url;
-                if (path.startsWith("/"))
-                    path = path.substring(1);
-                if (path.isEmpty())
-                    path = "index.html";
-
-                auto file = resourcesDir.getChildFile(path);
-                if (!file.existsAsFile())
-                    return std::nullopt;
-
-                juce::String mimeType = "application/octet-stream";
-                if (path.endsWith(".html")) mimeType = "text/html";
-                else if (path.endsWith(".css")) mimeType = "text/css";
-                else if (path.endsWith(".js")) mimeType = "application/javascript";
-                else if (path.endsWith(".json")) mimeType = "application/json";
-                else if (path.endsWith(".png")) mimeType = "image/png";
-                else if (path.endsWith(".svg")) mimeType = "image/svg+xml";
-
-                juce::MemoryBlock data;
-                file.loadFileAsData(data);
-
-                return juce::WebBrowserComponent::Resource{
-                    std::vector<std::byte>(
-                        reinterpret_cast<const std::byte*>(data.getData()),
-                        reinterpret_cast<const std::byte*>(data.getData()) + data.getSize()),
-                    mimeType.toStdString()
-                };
+                return WebUIResources::getInstance().getResource(url);
             })
         .withOptionsFrom(*freezeRelay)
         .withOptionsFrom(*smearRelay)
@@ -149,6 +159,18 @@ void RippleEditor::setupWebView()
                     juce::File::getSpecialLocation(juce::File::tempDirectory)
                         .getChildFile("Ripple_WebView2")));
 
+    for (int i = 0; i < ModulationEngine::NUM_LFOS; ++i)
+        options = options.withOptionsFrom(*lfoRateRelays[i])
+                         .withOptionsFrom(*lfoShapeRelays[i])
+                         .withOptionsFrom(*lfoPhaseRelays[i]);
+
+    options = options.withOptionsFrom(*lfoSyncRelay);
+
+    for (int i = 0; i < ModulationEngine::NUM_SLOTS; ++i)
+        options = options.withOptionsFrom(*modSourceRelays[i])
+                         .withOptionsFrom(*modTargetRelays[i])
+                         .withOptionsFrom(*modDepthRelays[i]);
+
     webView = std::make_unique<juce::WebBrowserComponent>(options);
     addAndMakeVisible(*webView);
 
@@ -172,6 +194,29 @@ void RippleEditor::setupRelaysAndAttachments()
         *apvts.getParameter("tilt"), *tiltRelay, nullptr);
     feedbackAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
         *apvts.getParameter("feedback"), *feedbackRelay, nullptr);
+
+    for (int i = 0; i < ModulationEngine::NUM_LFOS; ++i)
+    {
+        lfoRateAttachments[i] = std::make_unique<juce::WebSliderParameterAttachment>(
+            *apvts.getParameter(ModulationEngine::rateIDs[i]), *lfoRateRelays[i], nullptr);
+        lfoShapeAttachments[i] = std::make_unique<juce::WebComboBoxParameterAttachment>(
+            *apvts.getParameter(ModulationEngine::shapeIDs[i]), *lfoShapeRelays[i], nullptr);
+        lfoPhaseAttachments[i] = std::make_unique<juce::WebSliderParameterAttachment>(
+            *apvts.getParameter(ModulationEngine::phaseIDs[i]), *lfoPhaseRelays[i], nullptr);
+    }
+
+    lfoSyncAttachment = std::make_unique<juce::WebToggleButtonParameterAttachment>(
+        *apvts.getParameter(ParamIDs::lfoSync), *lfoSyncRelay, nullptr);
+
+    for (int i = 0; i < ModulationEngine::NUM_SLOTS; ++i)
+    {
+        modSourceAttachments[i] = std::make_unique<juce::WebComboBoxParameterAttachment>(
+            *apvts.getParameter(ModulationEngine::sourceIDs[i]), *modSourceRelays[i], nullptr);
+        modTargetAttachments[i] = std::make_unique<juce::WebComboBoxParameterAttachment>(
+            *apvts.getParameter(ModulationEngine::targetIDs[i]), *modTargetRelays[i], nullptr);
+        modDepthAttachments[i] = std::make_unique<juce::WebSliderParameterAttachment>(
+            *apvts.getParameter(ModulationEngine::depthIDs[i]), *modDepthRelays[i], nullptr);
+    }
 }
 
 //==============================================================================
@@ -185,44 +230,48 @@ void RippleEditor::sendSpectrumData()
     if (!webView)
         return;
 
-    juce::DynamicObject::Ptr data = new juce::DynamicObject();
+    auto& data = *spectrumEvent;
 
     // Audio levels
-    data->setProperty("inputLevel", processorRef.getInputLevel());
-    data->setProperty("outputLevel", processorRef.getOutputLevel());
-
-    // Spectrum data (downsample for performance)
-    constexpr int SEND_BINS = 256;  // Send fewer bins for performance
-    std::vector<float> spectrum(RippleProcessor::SPECTRUM_SIZE);
-    processorRef.getSpectrum(spectrum.data());
-
-    juce::Array<juce::var> spectrumArray;
-    int step = RippleProcessor::SPECTRUM_SIZE / SEND_BINS;
-    for (int i = 0; i < SEND_BINS; ++i)
+    data.setProperty("inputLevel", processorRef.getInputLevel());
+    data.setProperty("outputLevel", processorRef.getOutputLevel());
+
+    // CPU meter: fractions of the block budget, the histogram as the share
+    // of all blocks in each 10% band
+    const auto stats = processorRef.readDSPStats();
+    data.setProperty("cpuLoad", stats.load);
+    data.setProperty("cpuPeak", stats.peakLoad);
+    data.setProperty("cpuWorst", stats.worstLoad);
+    data.setProperty("blockMs", stats.meanBlockMs);
+    data.setProperty("framesPerBlock", stats.framesPerBlock);
+
+    auto& histogram = *cpuHistogram.getArray();
+    histogram.resize(DSPStats::NUM_BUCKETS);
+    for (int i = 0; i < DSPStats::NUM_BUCKETS; ++i)
+        histogram.getReference(i) = stats.numBlocks > 0 ? static_cast<double>(stats.histogram[static_cast<size_t>(i)])
+                                                              / static_cast<double>(stats.numBlocks)
+                                                        : 0.0;
+    data.setProperty("cpuHistogram", cpuHistogram);
+
+    // Spectrum data, mapped here rather than on the audio thread.
+    // Only sent when the processor has published a new frame.
+    if (spectrumDisplay.update(processorRef.readSpectrum()))
     {
-        // Average bins for this step
-        float sum = 0.0f;
-        for (int j = 0; j < step; ++j)
-            sum += spectrum[i * step + j];
-        spectrumArray.add(sum / step);
+        constexpr int bands = SpectrumDisplay::NUM_BANDS;
+        quantise(spectrumDisplay.getSpectrum(), spectrumPayload.data());
+        quantise(spectrumDisplay.getFrozen(), spectrumPayload.data() + bands);
+        quantise(spectrumDisplay.getPeaks(), spectrumPayload.data() + bands * 2);
+        encodeBase64(spectrumPayload.data(), SPECTRUM_PAYLOAD_BYTES, spectrumBase64.data());
+
+        data.setProperty("bands", bands);
+        data.setProperty("spectrumU8", juce::String(spectrumBase64.data(), spectrumBase64.size()));
     }
-    data->setProperty("spectrum", spectrumArray);
-
-    // Frozen spectrum
-    std::vector<float> frozen(RippleProcessor::SPECTRUM_SIZE);
-    processorRef.getFrozenSpectrum(frozen.data());
-
-    juce::Array<juce::var> frozenArray;
-    for (int i = 0; i < SEND_BINS; ++i)
+    else
     {
-        float sum = 0.0f;
-        for (int j = 0; j < step; ++j)
-            sum += frozen[i * step + j];
-        frozenArray.add(sum / step);
+        data.removeProperty("spectrumU8");
     }
-    data->setProperty("frozen", frozenArray);
 
-    webView->emitEventIfBrowserIsVisible("spectrumData", juce::var(data.get()));
+    webView->emitEventIfBrowserIsVisible("spectrumData", juce::var(spectrumEvent.get()));
 }
 
 void RippleEditor::handleInteraction(const juce::var& data)
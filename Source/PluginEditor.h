@@ -10,6 +10,7 @@
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_gui_extra/juce_gui_extra.h>
 #include "PluginProcessor.h"
+#include "SpectrumDisplay.h"
 
 //==============================================================================
 class RippleEditor : public juce::AudioProcessorEditor,
@@ -27,7 +28,16 @@ private:
     RippleProcessor& processorRef;
 
     std::unique_ptr<juce::WebBrowserComponent> webView;
-    juce::File resourcesDir;
+
+    SpectrumDisplay spectrumDisplay;
+
+    // spectrumData event, reused every tick. The bands go out as one base64
+    // string of 8-bit values: spectrum, frozen, then peaks.
+    static constexpr int SPECTRUM_PAYLOAD_BYTES = SpectrumDisplay::NUM_BANDS * 3;
+    std::array<juce::uint8, SPECTRUM_PAYLOAD_BYTES> spectrumPayload {};
+    std::array<char, (SPECTRUM_PAYLOAD_BYTES + 2) / 3 * 4> spectrumBase64 {};
+    juce::DynamicObject::Ptr spectrumEvent { new juce::DynamicObject() };
+    juce::var cpuHistogram { juce::Array<juce::var>() };
 
     // Parameter relays
     std::unique_ptr<juce::WebSliderRelay> freezeRelay;
@@ -45,6 +55,29 @@ private:
     std::unique_ptr<juce::WebSliderParameterAttachment> tiltAttachment;
     std::unique_ptr<juce::WebSliderParameterAttachment> feedbackAttachment;
 
+    // LFO and mod matrix relays and attachments, indexed like
+    // ModulationEngine's ID tables
+    template <typename T>
+    using PerLFO = std::array<std::unique_ptr<T>, ModulationEngine::NUM_LFOS>;
+    template <typename T>
+    using PerSlot = std::array<std::unique_ptr<T>, ModulationEngine::NUM_SLOTS>;
+
+    PerLFO<juce::WebSliderRelay> lfoRateRelays;
+    PerLFO<juce::WebComboBoxRelay> lfoShapeRelays;
+    PerLFO<juce::WebSliderRelay> lfoPhaseRelays;
+    std::unique_ptr<juce::WebToggleButtonRelay> lfoSyncRelay;
+    PerSlot<juce::WebComboBoxRelay> modSourceRelays;
+    PerSlot<juce::WebComboBoxRelay> modTargetRelays;
+    PerSlot<juce::WebSliderRelay> modDepthRelays;
+
+    PerLFO<juce::WebSliderParameterAttachment> lfoRateAttachments;
+    PerLFO<juce::WebComboBoxParameterAttachment> lfoShapeAttachments;
+    PerLFO<juce::WebSliderParameterAttachment> lfoPhaseAttachments;
+    std::unique_ptr<juce::WebToggleButtonParameterAttachment> lfoSyncAttachment;
+    PerSlot<juce::WebComboBoxParameterAttachment> modSourceAttachments;
+    PerSlot<juce::WebComboBoxParameterAttachment> modTargetAttachments;
+    PerSlot<juce::WebSliderParameterAttachment> modDepthAttachments;
+
     void setupWebView();
     void setupRelaysAndAttachments();
     void sendSpectrumData();
@@ -6,6 +6,7 @@
 
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "ParameterIDs.h"
 
 #if HAS_PROJECT_DATA
 #include "ProjectData.h"
@@ -23,21 +24,89 @@ namespace ParamIDs
     static constexpr const char* shift = "shift";
     static constexpr const char* tilt = "tilt";
     static constexpr const char* feedback = "feedback";
+    static constexpr const char* stereoLink = "stereo_link";
+    static constexpr const char* fftSize = "fft_size";
+    static constexpr const char* overlap = "overlap";
+    static constexpr const char* pipelined = "pipelined";
 }
 
-static constexpr int kStateVersion = 2;
+// 1 and 2 are the APVTS tree as XML (copyXmlToBinary, with a stateVersion
+// attribute from 2); 3 is the binary layout in writeBinaryState()
+static constexpr int kStateVersion = 3;
+static constexpr juce::uint32 kStateMagic = 0x534c5052;   // "RPLS" in the first four bytes
+
+namespace
+{
+    // Frozen magnitudes as 16-bit dB codes: 0 is silence, 1 to 65535 span
+    // -150 to +30 dB of the frame-size-normalised magnitude, 0.003 dB a step
+    constexpr float frozenFloorDb = -150.0f;
+    constexpr float frozenRangeDb = 180.0f;
+
+    int encodeFrozen(float magnitude)
+    {
+        const float db = juce::Decibels::gainToDecibels(magnitude, frozenFloorDb - 1.0f);
+        if (db < frozenFloorDb)
+            return 0;
+
+        return 1 + juce::roundToInt(juce::jmin(1.0f, (db - frozenFloorDb) / frozenRangeDb) * 65534.0f);
+    }
+
+    float decodeFrozen(int code)
+    {
+        if (code == 0)
+            return 0.0f;
+
+        return juce::Decibels::decibelsToGain(frozenFloorDb + static_cast<float>(code - 1) / 65534.0f * frozenRangeDb);
+    }
+}
 
 //==============================================================================
 RippleProcessor::RippleProcessor()
     : AudioProcessor(BusesProperties()
                      .withInput("Input", juce::AudioChannelSet::stereo(), true)
                      .withOutput("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts(*this, nullptr, "Parameters", createParameterLayout())
+      apvts(*this, nullptr, "Parameters", createParameterLayout()),
+      modulation(apvts)
 {
+    freezeParam = apvts.getRawParameterValue(ParamIDs::freeze);
+    smearParam = apvts.getRawParameterValue(ParamIDs::smear);
+    scatterParam = apvts.getRawParameterValue(ParamIDs::scatter);
+    shiftParam = apvts.getRawParameterValue(ParamIDs::shift);
+    tiltParam = apvts.getRawParameterValue(ParamIDs::tilt);
+    feedbackParam = apvts.getRawParameterValue(ParamIDs::feedback);
+    stereoLinkParam = apvts.getRawParameterValue(ParamIDs::stereoLink);
+    fftSizeParam = apvts.getRawParameterValue(ParamIDs::fftSize);
+    overlapParam = apvts.getRawParameterValue(ParamIDs::overlap);
+    pipelinedParam = apvts.getRawParameterValue(ParamIDs::pipelined);
+    randomSeedParam = apvts.getRawParameterValue(ParamIDs::randomSeed);
+
+    rippleRateParam = apvts.getParameter(ParamIDs::rippleRate);
+    rippleMultiplyParam = apvts.getParameter(ParamIDs::rippleMultiply);
+    rippleAmountParam = apvts.getParameter(ParamIDs::rippleAmount);
+    rippleWidthParam = apvts.getParameter(ParamIDs::rippleWidth);
+    rippleLowBypassParam = apvts.getParameter(ParamIDs::rippleLowBypass);
+    rippleHighBypassParam = apvts.getParameter(ParamIDs::rippleHighBypass);
+    rippleMixParam = apvts.getParameter(ParamIDs::rippleMix);
+
+    reverbEnabledParam = apvts.getRawParameterValue(ParamIDs::reverbEnabled);
+    reverbSizeParam = apvts.getParameter(ParamIDs::reverbSize);
+    reverbDampingParam = apvts.getParameter(ParamIDs::reverbDamping);
+    reverbMixParam = apvts.getParameter(ParamIDs::reverbMix);
+
+    spectralProcessor.setModulation(&modulation);
+
     loadProjectData();
+
+    // The pipelined switch and the latency of a new frame size are followed
+    // within a few blocks; until the pool is joined its frames run on the
+    // audio thread
+    startTimerHz(10);
 }
 
-RippleProcessor::~RippleProcessor() {}
+RippleProcessor::~RippleProcessor()
+{
+    stopTimer();
+}
 
 //==============================================================================
 juce::AudioProcessorValueTreeState::ParameterLayout RippleProcessor::createParameterLayout()
@@ -68,6 +137,110 @@ juce::AudioProcessorValueTreeState::ParameterLayout RippleProcessor::createParam
         juce::ParameterID { ParamIDs::feedback, 1 }, "Feedback",
         juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.0f));
 
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID { ParamIDs::stereoLink, 1 }, "Stereo Link", false));
+
+    // Quality: "Auto" follows the sample rate, otherwise a fixed FFT size
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID { ParamIDs::fftSize, 1 }, "FFT Size",
+        juce::StringArray { "Auto", "256", "512", "1024", "2048", "4096", "8192" }, 0));
+
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID { ParamIDs::overlap, 1 }, "Overlap",
+        juce::StringArray { "2x", "4x", "8x" }, 1));
+
+    // Frames on the shared worker pool, for a block of extra latency
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID { ParamIDs::pipelined, 1 }, "Pipelined", false));
+
+    // Keys the scatter phase noise and the random LFO steps: same seed, same render
+    params.push_back(std::make_unique<juce::AudioParameterInt>(
+        juce::ParameterID { ParamIDs::randomSeed, 1 }, "Random Seed", 0, 9999, 0));
+
+    // === RIPPLE FILTER (mix 0 = off) ===
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID { ParamIDs::rippleRate, 1 }, "Ripple Rate",
+        juce::NormalisableRange<float>(0.01f, 20.0f, 0.0f, 0.3f), 0.5f));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID { ParamIDs::rippleMultiply, 1 }, "Ripple Multiply",
+        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.5f));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID { ParamIDs::rippleAmount, 1 }, "Ripple Amount",
+        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.3f));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID { ParamIDs::rippleWidth, 1 }, "Ripple Width",
+        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.5f));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID { ParamIDs::rippleLowBypass, 1 }, "Ripple Low Bypass",
+        juce::NormalisableRange<float>(20.0f, 2000.0f, 0.0f, 0.3f), 80.0f));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID { ParamIDs::rippleHighBypass, 1 }, "Ripple High Bypass",
+        juce::NormalisableRange<float>(1000.0f, 20000.0f, 0.0f, 0.3f), 12000.0f));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID { ParamIDs::rippleMix, 1 }, "Ripple Mix",
+        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.0f));
+
+    // === REVERB ===
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID { ParamIDs::reverbEnabled, 1 }, "Reverb", false));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID { ParamIDs::reverbSize, 1 }, "Reverb Size",
+        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.5f));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID { ParamIDs::reverbDamping, 1 }, "Reverb Damping",
+        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.5f));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID { ParamIDs::reverbMix, 1 }, "Reverb Mix",
+        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.3f));
+
+    // === LFOs ===
+    for (int i = 0; i < ModulationEngine::NUM_LFOS; ++i)
+    {
+        const juce::String name = "LFO " + juce::String(i + 1);
+
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            juce::ParameterID { ModulationEngine::rateIDs[i], 1 }, name + " Rate",
+            juce::NormalisableRange<float>(0.01f, 20.0f, 0.0f, 0.3f), 0.5f));
+
+        params.push_back(std::make_unique<juce::AudioParameterChoice>(
+            juce::ParameterID { ModulationEngine::shapeIDs[i], 1 }, name + " Shape",
+            LFOShapes::shapes, 0));
+
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            juce::ParameterID { ModulationEngine::phaseIDs[i], 1 }, name + " Phase",
+            juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), static_cast<float>(i) * 0.25f));
+    }
+
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID { ParamIDs::lfoSync, 1 }, "LFO Sync", false));
+
+    // === MOD MATRIX: slot n defaults to LFO n with no target ===
+    for (int i = 0; i < ModulationEngine::NUM_SLOTS; ++i)
+    {
+        const juce::String name = "Mod " + juce::String(i + 1);
+
+        params.push_back(std::make_unique<juce::AudioParameterChoice>(
+            juce::ParameterID { ModulationEngine::sourceIDs[i], 1 }, name + " Source",
+            ModSources::sources, i + 1));
+
+        params.push_back(std::make_unique<juce::AudioParameterChoice>(
+            juce::ParameterID { ModulationEngine::targetIDs[i], 1 }, name + " Target",
+            ModTargets::targets, 0));
+
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            juce::ParameterID { ModulationEngine::depthIDs[i], 1 }, name + " Depth",
+            juce::NormalisableRange<float>(-1.0f, 1.0f, 0.01f), 0.0f));
+    }
+
     return { params.begin(), params.end() };
 }
 
@@ -76,7 +249,18 @@ const juce::String RippleProcessor::getName() const { return JucePlugin_Name; }
 bool RippleProcessor::acceptsMidi() const { return false; }
 bool RippleProcessor::producesMidi() const { return false; }
 bool RippleProcessor::isMidiEffect() const { return false; }
-double RippleProcessor::getTailLengthSeconds() const { return 2.0; }
+
+double RippleProcessor::getTailLengthSeconds() const
+{
+    // Smear and feedback ring on for a while after the input stops; the
+    // reverb, last in the chain, then decays over its current RT60
+    if (reverbEnabledParam->load() < 0.5f)
+        return SPECTRAL_TAIL_SECONDS;
+
+    return SPECTRAL_TAIL_SECONDS
+         + FDNReverb::getDecaySeconds(reverbSizeParam->convertFrom0to1(reverbSizeParam->getValue()));
+}
+
 int RippleProcessor::getNumPrograms() { return 1; }
 int RippleProcessor::getCurrentProgram() { return 0; }
 void RippleProcessor::setCurrentProgram(int) {}
@@ -86,25 +270,55 @@ void RippleProcessor::changeProgramName(int, const juce::String&) {}
 //==============================================================================
 void RippleProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
+    dspStats.prepare(sampleRate);
     spectralProcessor.prepare(sampleRate, samplesPerBlock);
+    updateFrameSize(sampleRate);
+    updateFramePool();
+    reportLatency();
+    modulation.prepare(sampleRate);
+    rippleFilter.prepare(sampleRate, getTotalNumOutputChannels());
+    reverb.prepare(sampleRate, getTotalNumOutputChannels());
+}
 
-    juce::dsp::ProcessSpec spec;
-    spec.sampleRate = sampleRate;
-    spec.maximumBlockSize = static_cast<juce::uint32>(samplesPerBlock);
-    spec.numChannels = static_cast<juce::uint32>(getTotalNumOutputChannels());
-
-    reverb.prepare(spec);
-    reverbParams.roomSize = 0.5f;
-    reverbParams.damping = 0.5f;
-    reverbParams.wetLevel = 0.3f;
-    reverbParams.dryLevel = 0.7f;
-    reverbParams.width = 1.0f;
-    reverb.setParameters(reverbParams);
+void RippleProcessor::updateFrameSize(double sampleRate)
+{
+    const int sizeChoice = static_cast<int>(fftSizeParam->load());
+    const int overlapChoice = static_cast<int>(overlapParam->load());
+
+    const int fftOrder = sizeChoice == 0 ? SpectralProcessor::getAutoFFTOrder(sampleRate)
+                                         : SpectralProcessor::MIN_FFT_ORDER + sizeChoice - 1;
+    const int overlap = 2 << juce::jlimit(0, 2, overlapChoice);
+
+    // No-op unless the mode changed; switching never allocates
+    spectralProcessor.setFrameSize(fftOrder, overlap);
+    spectralProcessor.setPipelined(pipelinedParam->load() > 0.5f);
+
+    spectralLatency.store(spectralProcessor.getLatencySamples(), std::memory_order_relaxed);
+}
+
+void RippleProcessor::reportLatency()
+{
+    const int latency = spectralLatency.load(std::memory_order_relaxed);
+    if (latency != getLatencySamples())
+        setLatencySamples(latency);
+}
+
+void RippleProcessor::timerCallback()
+{
+    updateFramePool();
+    reportLatency();
+}
+
+void RippleProcessor::updateFramePool()
+{
+    spectralProcessor.updatePoolMembership(pipelinedParam->load() > 0.5f);
 }
 
 void RippleProcessor::releaseResources()
 {
     spectralProcessor.reset();
+    modulation.reset();
+    rippleFilter.reset();
     reverb.reset();
 }
 
@@ -125,6 +339,9 @@ void RippleProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiB
 {
     juce::ScopedNoDenormals noDenormals;
 
+    const juce::int64 startTicks = juce::Time::getHighResolutionTicks();
+    const juce::int64 framesAtStart = spectralProcessor.getNumFramesProcessed();
+
     auto totalNumInputChannels = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
 
@@ -138,42 +355,57 @@ void RippleProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiB
     inputLevel.store(inLevel);
 
     // Get parameters
-    float freeze = apvts.getRawParameterValue(ParamIDs::freeze)->load();
-    float smear = apvts.getRawParameterValue(ParamIDs::smear)->load();
-    float scatter = apvts.getRawParameterValue(ParamIDs::scatter)->load();
-    float shift = apvts.getRawParameterValue(ParamIDs::shift)->load();
-    float tilt = apvts.getRawParameterValue(ParamIDs::tilt)->load();
-    float feedback = apvts.getRawParameterValue(ParamIDs::feedback)->load();
+    float freeze = freezeParam->load();
+    float smear = smearParam->load();
+    float scatter = scatterParam->load();
+    float shift = shiftParam->load();
+    float tilt = tiltParam->load();
+    float feedback = feedbackParam->load();
+    bool stereoLink = stereoLinkParam->load() > 0.5f;
 
     // Update spectral processor
+    updateFrameSize(getSampleRate());
     spectralProcessor.setFreezeAmount(freeze);
     spectralProcessor.setSmearAmount(smear);
     spectralProcessor.setScatterAmount(scatter);
     spectralProcessor.setShiftAmount(shift);
     spectralProcessor.setTiltAmount(tilt);
     spectralProcessor.setFeedbackAmount(feedback);
+    spectralProcessor.setStereoLinked(stereoLink);
+    spectralProcessor.setRandomSeed(static_cast<juce::uint32>(randomSeedParam->load()));
+    modulation.beginBlock(getPlayHead());
 
     // Process spectral
     spectralProcessor.process(buffer);
 
+    // Ripple filter, following the LFOs at block rate
+    rippleFilter.setRate(modulation.apply(ModulationEngine::rippleRate, *rippleRateParam));
+    rippleFilter.setMultiply(modulation.apply(ModulationEngine::rippleMultiply, *rippleMultiplyParam));
+    rippleFilter.setAmount(modulation.apply(ModulationEngine::rippleAmount, *rippleAmountParam));
+    rippleFilter.setWidth(modulation.apply(ModulationEngine::rippleWidth, *rippleWidthParam));
+    rippleFilter.setLowBypass(modulation.apply(ModulationEngine::rippleLowBypass, *rippleLowBypassParam));
+    rippleFilter.setHighBypass(modulation.apply(ModulationEngine::rippleHighBypass, *rippleHighBypassParam));
+    rippleFilter.setMix(modulation.apply(ModulationEngine::rippleMix, *rippleMixParam));
+    rippleFilter.process(buffer);
+
+    // Reverb; returns straight away while off
+    reverb.setEnabled(reverbEnabledParam->load() > 0.5f);
+    reverb.setSize(modulation.apply(ModulationEngine::reverbSize, *reverbSizeParam));
+    reverb.setDamping(modulation.apply(ModulationEngine::reverbDamping, *reverbDampingParam));
+    reverb.setMix(modulation.apply(ModulationEngine::reverbMix, *reverbMixParam));
+    reverb.process(buffer);
+
     // Output level
     float outLevel = 0.0f;
     for (int ch = 0; ch < totalNumOutputChannels; ++ch)
         outLevel = std::max(outLevel, buffer.getMagnitude(ch, 0, buffer.getNumSamples()));
     outputLevel.store(outLevel);
-}
-
-//==============================================================================
-void RippleProcessor::getSpectrum(float* magnitudes) const
-{
-    spectralProcessor.getMagnitudeSpectrum(magnitudes, SpectralProcessor::NUM_BINS);
-}
 
-void RippleProcessor::getFrozenSpectrum(float* magnitudes) const
-{
-    spectralProcessor.getFrozenSpectrum(magnitudes, SpectralProcessor::NUM_BINS);
+    dspStats.record(startTicks, juce::Time::getHighResolutionTicks(), buffer.getNumSamples(),
+                    static_cast<int>(spectralProcessor.getNumFramesProcessed() - framesAtStart));
 }
 
+//==============================================================================
 void RippleProcessor::setInteraction(float y, float radius, bool active)
 {
     spectralProcessor.setInteractionY(y);
@@ -192,19 +424,126 @@ juce::AudioProcessorEditor* RippleProcessor::createEditor()
 //==============================================================================
 void RippleProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
-    auto state = apvts.copyState();
-    std::unique_ptr<juce::XmlElement> xml(state.createXml());
-    xml->setAttribute("stateVersion", kStateVersion);
-    copyXmlToBinary(*xml, destData);
+    writeBinaryState(destData);
 }
 
 void RippleProcessor::setStateInformation(const void* data, int sizeInBytes)
 {
+    if (readBinaryState(data, sizeInBytes))
+        return;
+
+    // Sessions saved before kStateVersion 3
     std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
     if (xmlState != nullptr && xmlState->hasTagName(apvts.state.getType()))
         apvts.replaceState(juce::ValueTree::fromXml(*xmlState));
 }
 
+// Little-endian throughout:
+//   magic, version                        int32 x 2
+//   parameter count, then per parameter   int32; ID (UTF-8, null-terminated), value (float, in its own units)
+//   frozen spectrum count (0 or 1), then  int32
+//     the spectrum                        sample rate (double), frame size, bins, channels (int32 x 3),
+//                                         channels runs of bins 16-bit dB codes (encodeFrozen)
+void RippleProcessor::writeBinaryState(juce::MemoryBlock& destData)
+{
+    // Read straight from the parameters: no ValueTree copy, no XML
+    juce::Array<juce::RangedAudioParameter*> parameters;
+    for (auto* parameter : getParameters())
+        if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter))
+            parameters.add(ranged);
+
+    const auto frozen = spectralProcessor.getFrozenSpectrum();
+
+    juce::MemoryOutputStream stream(destData, false);
+
+    stream.writeInt(static_cast<int>(kStateMagic));
+    stream.writeInt(kStateVersion);
+
+    stream.writeInt(parameters.size());
+    for (auto* parameter : parameters)
+    {
+        stream.writeString(parameter->getParameterID());
+        stream.writeFloat(parameter->convertFrom0to1(parameter->getValue()));
+    }
+
+    stream.writeInt(frozen.numBins > 0 ? 1 : 0);
+    if (frozen.numBins > 0)
+    {
+        stream.writeDouble(frozen.sampleRate);
+        stream.writeInt(frozen.fftSize);
+        stream.writeInt(frozen.numBins);
+        stream.writeInt(SpectralProcessor::MAX_CHANNELS);
+
+        for (int i = 0; i < SpectralProcessor::MAX_CHANNELS * frozen.numBins; ++i)
+            stream.writeShort(static_cast<short>(encodeFrozen(frozen.magnitude[static_cast<size_t>(i)])));
+    }
+}
+
+bool RippleProcessor::readBinaryState(const void* data, int sizeInBytes)
+{
+    if (data == nullptr || sizeInBytes < 12 || juce::ByteOrder::littleEndianInt(data) != kStateMagic)
+        return false;
+
+    juce::MemoryInputStream stream(data, static_cast<size_t>(sizeInBytes), false);
+    stream.readInt();
+
+    if (stream.readInt() < 3)
+        return false;
+
+    // Everything is read and checked before any of it is applied, so a
+    // truncated blob changes nothing
+    struct Value { juce::String id; float value; };
+    std::vector<Value> values;
+
+    const int numParameters = stream.readInt();
+    if (numParameters < 0 || numParameters > 4096)
+        return false;
+
+    for (int i = 0; i < numParameters; ++i)
+    {
+        auto id = stream.readString();
+        values.push_back({ std::move(id), stream.readFloat() });
+    }
+
+    if (stream.getNumBytesRemaining() < 4)
+        return false;
+
+    const int numSpectra = stream.readInt();
+    if (numSpectra < 0 || numSpectra > 1)
+        return false;
+
+    SpectralProcessor::FrozenSpectrum frozen;
+    if (numSpectra == 1)
+    {
+        // Past the end the stream reads zeros, which would pass for an empty spectrum
+        if (stream.getNumBytesRemaining() < 20)
+            return false;
+
+        frozen.sampleRate = stream.readDouble();
+        frozen.fftSize = stream.readInt();
+        frozen.numBins = stream.readInt();
+        const int numChannels = stream.readInt();
+
+        if (frozen.numBins < 0 || frozen.numBins > SpectralProcessor::MAX_BINS
+            || numChannels < 0 || numChannels > SpectralProcessor::MAX_CHANNELS
+            || stream.getNumBytesRemaining() < static_cast<juce::int64>(numChannels) * frozen.numBins * 2)
+            return false;
+
+        frozen.magnitude.assign(static_cast<size_t>(SpectralProcessor::MAX_CHANNELS * frozen.numBins), 0.0f);
+        for (int i = 0; i < numChannels * frozen.numBins; ++i)
+            frozen.magnitude[static_cast<size_t>(i)] = decodeFrozen(static_cast<juce::uint16>(stream.readShort()));
+    }
+
+    // Unknown IDs are from a newer build; parameters missing here keep
+    // their values, the same as on the XML path
+    for (const auto& v : values)
+        if (auto* parameter = apvts.getParameter(v.id))
+            parameter->setValueNotifyingHost(parameter->convertTo0to1(v.value));
+
+    spectralProcessor.setFrozenSpectrum(frozen);
+    return true;
+}
+
 //==============================================================================
 bool RippleProcessor::hasActivationEnabled() const
 {
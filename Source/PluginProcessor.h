@@ -10,13 +10,18 @@
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
 #include "SpectralProcessor.h"
+#include "ModulationEngine.h"
+#include "RippleFilter.h"
+#include "FDNReverb.h"
+#include "DSPStats.h"
 
 #if BEATCONNECT_ACTIVATION_ENABLED
 #include <beatconnect/Activation.h>
 #endif
 
 //==============================================================================
-class RippleProcessor : public juce::AudioProcessor
+class RippleProcessor : public juce::AudioProcessor,
+                        private juce::Timer
 {
 public:
     RippleProcessor();
@@ -64,33 +69,93 @@ public:
     float getInputLevel() const { return inputLevel.load(); }
     float getOutputLevel() const { return outputLevel.load(); }
 
-    // Spectral data for visualization
-    static constexpr int SPECTRUM_SIZE = SpectralProcessor::NUM_BINS;
-    void getSpectrum(float* magnitudes) const;
-    void getFrozenSpectrum(float* magnitudes) const;
+    // Callback timing against the block budget (message thread only)
+    DSPStats::Snapshot readDSPStats() { return dspStats.read(); }
+    void resetDSPStats() { dspStats.reset(); }
+
+    // Spectral data for visualization (message thread only)
+    const SpectralProcessor::SpectrumSnapshot& readSpectrum() { return spectralProcessor.readSpectrum(); }
 
     // Interaction from UI
     void setInteraction(float y, float radius, bool active);
 
+    // Profiling access for the benchmark harness
+    const SpectralProcessor& getSpectralProcessor() const { return spectralProcessor; }
+
+    // Joins or leaves the shared frame pool to follow the pipelined
+    // parameter. Polled on the message thread; never from the audio thread.
+    void updateFramePool();
+
 private:
+    void timerCallback() override;
+
     juce::AudioProcessorValueTreeState apvts;
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+    void updateFrameSize(double sampleRate);
+
+    // setLatencySamples() notifies the host under a lock, so the audio thread
+    // only publishes the new latency and the message thread reports it
+    void reportLatency();
+    std::atomic<int> spectralLatency { 0 };
+
+    // Reported tail of the spectral stage alone (smear and feedback)
+    static constexpr double SPECTRAL_TAIL_SECONDS = 2.0;
+
+    // Binary session state (kStateVersion 3 on); readBinaryState returns
+    // false for anything else, which is left to the legacy XML path
+    void writeBinaryState(juce::MemoryBlock& destData);
+    bool readBinaryState(const void* data, int sizeInBytes);
+
     void loadProjectData();
     juce::String pluginId_;
     juce::String apiBaseUrl_;
     juce::String supabasePublishableKey_;
     juce::var buildFlags_;
 
+    // Parameter values, looked up once instead of by ID every block
+    std::atomic<float>* freezeParam = nullptr;
+    std::atomic<float>* smearParam = nullptr;
+    std::atomic<float>* scatterParam = nullptr;
+    std::atomic<float>* shiftParam = nullptr;
+    std::atomic<float>* tiltParam = nullptr;
+    std::atomic<float>* feedbackParam = nullptr;
+    std::atomic<float>* stereoLinkParam = nullptr;
+    std::atomic<float>* fftSizeParam = nullptr;
+    std::atomic<float>* overlapParam = nullptr;
+    std::atomic<float>* pipelinedParam = nullptr;
+    std::atomic<float>* randomSeedParam = nullptr;
+
+    // Ripple filter parameters, read through their ranges for modulation
+    juce::RangedAudioParameter* rippleRateParam = nullptr;
+    juce::RangedAudioParameter* rippleMultiplyParam = nullptr;
+    juce::RangedAudioParameter* rippleAmountParam = nullptr;
+    juce::RangedAudioParameter* rippleWidthParam = nullptr;
+    juce::RangedAudioParameter* rippleLowBypassParam = nullptr;
+    juce::RangedAudioParameter* rippleHighBypassParam = nullptr;
+    juce::RangedAudioParameter* rippleMixParam = nullptr;
+
+    // Reverb parameters, likewise
+    std::atomic<float>* reverbEnabledParam = nullptr;
+    juce::RangedAudioParameter* reverbSizeParam = nullptr;
+    juce::RangedAudioParameter* reverbDampingParam = nullptr;
+    juce::RangedAudioParameter* reverbMixParam = nullptr;
+
     std::atomic<float> inputLevel { 0.0f };
     std::atomic<float> outputLevel { 0.0f };
 
-    // Spectral processing
+    // Timing of every processBlock, for the editor's CPU meter
+    DSPStats dspStats;
+
+    // Spectral processing, with the LFOs stepped once per hop
     SpectralProcessor spectralProcessor;
+    ModulationEngine modulation;
+
+    // Modulated filter bank after the spectral stage
+    RippleFilter rippleFilter;
 
-    // Simple reverb for added space
-    juce::dsp::Reverb reverb;
-    juce::dsp::Reverb::Parameters reverbParams;
+    // Feedback delay network reverb, last in the chain
+    FDNReverb reverb;
 
     juce::Random random;
 
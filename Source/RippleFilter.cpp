@@ -0,0 +1,226 @@
+/*
+  ==============================================================================
+    RIPPLE - Ripple Filter Implementation
+  ==============================================================================
+*/
+
+#include "RippleFilter.h"
+#include "SpectralKernels.h"
+#include "SimdOps.h"
+#include <cmath>
+
+void RippleFilter::prepare(double newSampleRate, int newNumChannels)
+{
+    sampleRate = newSampleRate;
+    numChannels = juce::jlimit(1, MAX_CHANNELS, newNumChannels);
+    reset();
+}
+
+void RippleFilter::reset()
+{
+    for (auto* coefficients : { &current, &target, &step })
+    {
+        coefficients->b0.fill(0.0f);
+        coefficients->a1.fill(0.0f);
+        coefficients->a2.fill(0.0f);
+        coefficients->weight.fill(0.0f);
+    }
+
+    state1.fill(0.0f);
+    state2.fill(0.0f);
+    bandsLow = 0.0f;
+    bandsHigh = 0.0f;
+    wavePhase = 0.0;
+    samplesUntilUpdate = 0;
+    idle = true;
+}
+
+void RippleFilter::updateBands(float low, float high)
+{
+    bandsLow = low;
+    bandsHigh = high;
+
+    // Log-spaced centres; each band is as wide as the spacing, so neighbours
+    // cross half way between their centres
+    const double ratio = std::pow(static_cast<double>(high) / low, 1.0 / (NUM_BANDS - 1));
+    const double bandwidth = std::exp2(juce::jmax(std::log2(ratio), 0.1));
+    const double q = std::sqrt(bandwidth) / (bandwidth - 1.0);
+
+    double centre = low;
+    for (int band = 0; band < NUM_BANDS; ++band)
+    {
+        const double w0 = juce::MathConstants<double>::twoPi * centre / sampleRate;
+        const double alpha = std::sin(w0) / (2.0 * q);
+        const double a0 = 1.0 + alpha;
+
+        // Band-pass with 0 dB peak: b1 = 0, b2 = -b0
+        bandB0[band] = static_cast<float>(alpha / a0);
+        bandA1[band] = static_cast<float>(-2.0 * std::cos(w0) / a0);
+        bandA2[band] = static_cast<float>((1.0 - alpha) / a0);
+
+        centre *= ratio;
+    }
+}
+
+void RippleFilter::updateTargets()
+{
+    // The last ramp has run its course; start exactly from where it aimed
+    current = target;
+
+    const float nyquistLimit = static_cast<float>(sampleRate * 0.45);
+    const float low = juce::jlimit(20.0f, nyquistLimit, lowBypass.load());
+    const float high = juce::jlimit(low, nyquistLimit, highBypass.load());
+
+    if (low != bandsLow || high != bandsHigh)
+        updateBands(low, high);
+
+    wavePhase += rate.load() * CONTROL_INTERVAL / sampleRate;
+    wavePhase -= std::floor(wavePhase);
+
+    // The main wave travels up the bank, one cycle across it. The ripples
+    // within it run down the bank at twice the speed with three cycles.
+    const float stereoOffset = width.load() * 0.5f;
+    auto toAngle = [](double cycles)
+    {
+        return static_cast<float>((cycles - std::floor(cycles)) * juce::MathConstants<double>::twoPi);
+    };
+
+    for (int ch = 0; ch < MAX_CHANNELS; ++ch)
+    {
+        for (int band = 0; band < NUM_BANDS; ++band)
+        {
+            const int lane = ch * NUM_BANDS + band;
+            const double position = static_cast<double>(band) / NUM_BANDS;
+            const double offset = ch * stereoOffset;
+
+            waveAngles[lane] = toAngle(wavePhase - position + offset);
+            waveAngles[NUM_LANES + lane] = toAngle(2.0 * wavePhase + 3.0 * position + offset);
+        }
+    }
+
+    SpectralKernels::sinCos(waveAngles.data(), waveSines.data(), waveCosines.data(), NUM_LANES * 2);
+
+    const float depth = MAX_DEPTH_DB * multiply.load();
+    const float amount = rippleAmount.load();
+    const float wet = mix.load();
+    constexpr float dbToNaturalLog = 0.11512925f;   // ln(10) / 20
+
+    bool allZero = true;
+    for (int lane = 0; lane < NUM_LANES; ++lane)
+    {
+        const int band = lane % NUM_BANDS;
+        const float db = depth * ((1.0f - amount) * waveSines[lane] + amount * waveSines[NUM_LANES + lane]);
+
+        target.b0[lane] = bandB0[band];
+        target.a1[lane] = bandA1[band];
+        target.a2[lane] = bandA2[band];
+        target.weight[lane] = wet * (std::exp(db * dbToNaturalLog) - 1.0f);
+
+        allZero = allZero && target.weight[lane] == 0.0f && current.weight[lane] == 0.0f;
+    }
+
+    constexpr float perSample = 1.0f / CONTROL_INTERVAL;
+    for (int lane = 0; lane < NUM_LANES; ++lane)
+    {
+        step.b0[lane] = (target.b0[lane] - current.b0[lane]) * perSample;
+        step.a1[lane] = (target.a1[lane] - current.a1[lane]) * perSample;
+        step.a2[lane] = (target.a2[lane] - current.a2[lane]) * perSample;
+        step.weight[lane] = (target.weight[lane] - current.weight[lane]) * perSample;
+    }
+
+    idle = allZero;
+}
+
+template <typename Ops>
+void RippleFilter::processSegment(float* const* channelData, int numChannelsToProcess, int numSamples)
+{
+    using V = typename Ops::V;
+    static_assert(NUM_BANDS % Ops::width == 0, "A vector must not straddle two channels");
+
+    std::array<float, CONTROL_INTERVAL> wetSum;
+
+    for (int ch = 0; ch < numChannelsToProcess; ++ch)
+    {
+        float* samples = channelData[ch];
+        std::fill(wetSum.begin(), wetSum.begin() + numSamples, 0.0f);
+
+        for (int lane = ch * NUM_BANDS; lane < (ch + 1) * NUM_BANDS; lane += Ops::width)
+        {
+            V b0 = Ops::load(current.b0.data() + lane);
+            V a1 = Ops::load(current.a1.data() + lane);
+            V a2 = Ops::load(current.a2.data() + lane);
+            V weight = Ops::load(current.weight.data() + lane);
+            const V b0Step = Ops::load(step.b0.data() + lane);
+            const V a1Step = Ops::load(step.a1.data() + lane);
+            const V a2Step = Ops::load(step.a2.data() + lane);
+            const V weightStep = Ops::load(step.weight.data() + lane);
+
+            V s1 = Ops::load(state1.data() + lane);
+            V s2 = Ops::load(state2.data() + lane);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const V input = Ops::mul(b0, Ops::set(samples[i]));
+                const V output = Ops::add(input, s1);
+                s1 = Ops::sub(s2, Ops::mul(a1, output));
+                s2 = Ops::sub(Ops::sub(Ops::set(0.0f), input), Ops::mul(a2, output));
+
+                wetSum[i] += Ops::sum(Ops::mul(weight, output));
+
+                b0 = Ops::add(b0, b0Step);
+                a1 = Ops::add(a1, a1Step);
+                a2 = Ops::add(a2, a2Step);
+                weight = Ops::add(weight, weightStep);
+            }
+
+            Ops::store(current.b0.data() + lane, b0);
+            Ops::store(current.a1.data() + lane, a1);
+            Ops::store(current.a2.data() + lane, a2);
+            Ops::store(current.weight.data() + lane, weight);
+            Ops::store(state1.data() + lane, s1);
+            Ops::store(state2.data() + lane, s2);
+        }
+
+        juce::FloatVectorOperations::add(samples, wetSum.data(), numSamples);
+    }
+}
+
+void RippleFilter::process(juce::AudioBuffer<float>& buffer)
+{
+    // Settled at unity with nothing to fade in
+    if (idle && (mix.load() <= 0.0f || multiply.load() <= 0.0f))
+        return;
+
+    const int numSamples = buffer.getNumSamples();
+    const int channelsToProcess = juce::jmin(numChannels, buffer.getNumChannels());
+
+    std::array<float*, MAX_CHANNELS> channelData {};
+    int position = 0;
+
+    while (position < numSamples)
+    {
+        if (samplesUntilUpdate == 0)
+        {
+            updateTargets();
+            samplesUntilUpdate = CONTROL_INTERVAL;
+
+            // Faded out: drop the band state and stop until turned up again
+            if (idle)
+            {
+                state1.fill(0.0f);
+                state2.fill(0.0f);
+                samplesUntilUpdate = 0;
+                return;
+            }
+        }
+
+        const int segment = juce::jmin(numSamples - position, samplesUntilUpdate);
+        for (int ch = 0; ch < channelsToProcess; ++ch)
+            channelData[ch] = buffer.getWritePointer(ch) + position;
+
+        processSegment<SimdOps::VectorOps>(channelData.data(), channelsToProcess, segment);
+
+        position += segment;
+        samplesUntilUpdate -= segment;
+    }
+}
@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+    RIPPLE - Ripple Filter
+    Modulated filter bank for the ripple_* parameters: band-pass bands spread
+    between the low and high bypass frequencies, added back onto the signal
+    with gains that a travelling wave sweeps up and down the bank. Nothing
+    outside the bypass range is touched.
+
+    Bands and channels run side by side in SIMD lanes. Coefficients are
+    worked out once every CONTROL_INTERVAL samples and ramped linearly in
+    between, never per sample.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include <array>
+#include <atomic>
+
+class RippleFilter
+{
+public:
+    static constexpr int NUM_BANDS = 8;
+    static constexpr int MAX_CHANNELS = 2;
+    static constexpr int NUM_LANES = NUM_BANDS * MAX_CHANNELS;  // lane = channel * NUM_BANDS + band
+    static constexpr int CONTROL_INTERVAL = 32;
+
+    // Peak band gain at full multiply
+    static constexpr float MAX_DEPTH_DB = 12.0f;
+
+    void prepare(double sampleRate, int numChannels);
+    void reset();
+
+    // Processes in place. Returns straight away while the mix (or the
+    // wave intensity) is zero and the bank has settled.
+    void process(juce::AudioBuffer<float>& buffer);
+
+    // Control parameters
+    void setRate(float hz) { rate.store(hz); }                       // Wave speed
+    void setMultiply(float amount) { multiply.store(amount); }       // 0 to 1, wave intensity
+    void setAmount(float amount) { rippleAmount.store(amount); }     // 0 to 1, ripples within ripples
+    void setWidth(float amount) { width.store(amount); }             // 0 to 1, up to half a cycle between channels
+    void setLowBypass(float hz) { lowBypass.store(hz); }             // Lowest band centre
+    void setHighBypass(float hz) { highBypass.store(hz); }           // Highest band centre
+    void setMix(float amount) { mix.store(amount); }                 // 0 to 1
+
+private:
+    // One control step: new coefficient targets and per-sample ramps
+    void updateTargets();
+    void updateBands(float low, float high);
+
+    template <typename Ops>
+    void processSegment(float* const* channelData, int numChannelsToProcess, int numSamples);
+
+    double sampleRate = 44100.0;
+    int numChannels = MAX_CHANNELS;
+    int samplesUntilUpdate = 0;
+    bool idle = true;
+
+    // Wave position in cycles, advanced once per control step
+    double wavePhase = 0.0;
+
+    // Band centre cache (shared by both channels), rebuilt when the bypass
+    // range or sample rate changes
+    std::array<float, NUM_BANDS> bandB0;
+    std::array<float, NUM_BANDS> bandA1;
+    std::array<float, NUM_BANDS> bandA2;
+    float bandsLow = 0.0f;
+    float bandsHigh = 0.0f;
+
+    // Per lane: band-pass y = b0 x + s1, s1 = s2 - a1 y, s2 = -b0 x - a2 y,
+    // and the weight it's added back with (mix * (gain - 1)).
+    // Current values ramp towards the targets by the step each sample.
+    struct Coefficients
+    {
+        alignas(32) std::array<float, NUM_LANES> b0;
+        alignas(32) std::array<float, NUM_LANES> a1;
+        alignas(32) std::array<float, NUM_LANES> a2;
+        alignas(32) std::array<float, NUM_LANES> weight;
+    };
+
+    Coefficients current;
+    Coefficients target;
+    Coefficients step;
+
+    alignas(32) std::array<float, NUM_LANES> state1;
+    alignas(32) std::array<float, NUM_LANES> state2;
+
+    // Wave angles and their sines for one control step
+    std::array<float, NUM_LANES * 2> waveAngles;
+    std::array<float, NUM_LANES * 2> waveSines;
+    std::array<float, NUM_LANES * 2> waveCosines;
+
+    // Parameters
+    std::atomic<float> rate { 0.5f };
+    std::atomic<float> multiply { 0.5f };
+    std::atomic<float> rippleAmount { 0.3f };
+    std::atomic<float> width { 0.5f };
+    std::atomic<float> lowBypass { 80.0f };
+    std::atomic<float> highBypass { 12000.0f };
+    std::atomic<float> mix { 0.0f };
+};
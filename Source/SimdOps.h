@@ -0,0 +1,293 @@
+/*
+  ==============================================================================
+    RIPPLE - SIMD Operations
+    The small set of vector operations the kernels are written against, one
+    struct per instruction set. VectorOps is the widest one compiled in:
+    AVX2 when the build enables it, SSE2 on x86-64, NEON on ARM64, plain C++
+    otherwise. ScalarOps handles leftovers with the same arithmetic.
+    Private to the DSP sources; not part of any public interface.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <cmath>
+
+#if defined(__AVX2__)
+ #include <immintrin.h>
+ #define RIPPLE_SIMD_AVX2 1
+ #define RIPPLE_SIMD_SSE2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #include <emmintrin.h>
+ #define RIPPLE_SIMD_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+ #include <arm_neon.h>
+ #define RIPPLE_SIMD_NEON 1
+#endif
+
+namespace SimdOps
+{
+    struct ScalarOps
+    {
+        using V = float;   // Values
+        using M = bool;    // Lane masks
+        using I = int;     // Integer lanes
+        static constexpr int width = 1;
+
+        static V set(float x) { return x; }
+        static V load(const float* p) { return *p; }
+        static void store(float* p, V v) { *p = v; }
+        static void loadComplex(const float* p, V& re, V& im) { re = p[0]; im = p[1]; }
+        static void storeComplex(float* p, V re, V im) { p[0] = re; p[1] = im; }
+
+        static V add(V a, V b) { return a + b; }
+        static V sub(V a, V b) { return a - b; }
+        static V mul(V a, V b) { return a * b; }
+        static V div(V a, V b) { return a / b; }
+        static V sqrt(V a) { return std::sqrt(a); }
+        static V min(V a, V b) { return a < b ? a : b; }
+        static V max(V a, V b) { return a > b ? a : b; }
+        static V abs(V a) { return std::abs(a); }
+        static float sum(V a) { return a; }
+
+        static M greater(V a, V b) { return a > b; }
+        static M less(V a, V b) { return a < b; }
+        static V select(M m, V a, V b) { return m ? a : b; }
+
+        static I roundToInt(V a) { return static_cast<int>(std::lrint(a)); }
+        static V toFloat(I a) { return static_cast<float>(a); }
+        static I addInt(I a, int b) { return a + b; }
+        static M hasBit(I a, int bit) { return (a & bit) != 0; }
+
+        // Unsigned 32-bit wraparound, for the noise hash
+        static I indices(int start) { return start; }
+        static I xorInt(I a, I b) { return a ^ b; }
+        static I mulInt(I a, unsigned int b) { return static_cast<int>(static_cast<unsigned int>(a) * b); }
+        template <int bits> static I shiftRight(I a) { return static_cast<int>(static_cast<unsigned int>(a) >> bits); }
+    };
+
+   #if RIPPLE_SIMD_SSE2
+    struct SSE2Ops
+    {
+        using V = __m128;
+        using M = __m128;
+        using I = __m128i;
+        static constexpr int width = 4;
+
+        static V set(float x) { return _mm_set1_ps(x); }
+        static V load(const float* p) { return _mm_loadu_ps(p); }
+        static void store(float* p, V v) { _mm_storeu_ps(p, v); }
+
+        static void loadComplex(const float* p, V& re, V& im)
+        {
+            const V a = _mm_loadu_ps(p);
+            const V b = _mm_loadu_ps(p + 4);
+            re = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+            im = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+        }
+
+        static void storeComplex(float* p, V re, V im)
+        {
+            _mm_storeu_ps(p, _mm_unpacklo_ps(re, im));
+            _mm_storeu_ps(p + 4, _mm_unpackhi_ps(re, im));
+        }
+
+        static V add(V a, V b) { return _mm_add_ps(a, b); }
+        static V sub(V a, V b) { return _mm_sub_ps(a, b); }
+        static V mul(V a, V b) { return _mm_mul_ps(a, b); }
+        static V div(V a, V b) { return _mm_div_ps(a, b); }
+        static V sqrt(V a) { return _mm_sqrt_ps(a); }
+        static V min(V a, V b) { return _mm_min_ps(a, b); }
+        static V max(V a, V b) { return _mm_max_ps(a, b); }
+        static V abs(V a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+
+        static float sum(V a)
+        {
+            const V pairs = _mm_add_ps(a, _mm_movehl_ps(a, a));
+            return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, _MM_SHUFFLE(1, 1, 1, 1))));
+        }
+
+        static M greater(V a, V b) { return _mm_cmpgt_ps(a, b); }
+        static M less(V a, V b) { return _mm_cmplt_ps(a, b); }
+        static V select(M m, V a, V b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+
+        static I roundToInt(V a) { return _mm_cvtps_epi32(a); }
+        static V toFloat(I a) { return _mm_cvtepi32_ps(a); }
+        static I addInt(I a, int b) { return _mm_add_epi32(a, _mm_set1_epi32(b)); }
+        static M hasBit(I a, int bit)
+        {
+            const I b = _mm_set1_epi32(bit);
+            return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(a, b), b));
+        }
+
+        static I indices(int start) { return _mm_add_epi32(_mm_set1_epi32(start), _mm_setr_epi32(0, 1, 2, 3)); }
+        static I xorInt(I a, I b) { return _mm_xor_si128(a, b); }
+        template <int bits> static I shiftRight(I a) { return _mm_srli_epi32(a, bits); }
+
+        static I mulInt(I a, unsigned int b)
+        {
+            // SSE2 only multiplies lanes 0 and 2 to 64 bits; do the odd lanes
+            // separately and keep the low halves
+            const I factor = _mm_set1_epi32(static_cast<int>(b));
+            const I even = _mm_mul_epu32(a, factor);
+            const I odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), factor);
+            return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                                      _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+        }
+    };
+   #endif
+
+   #if RIPPLE_SIMD_AVX2
+    struct AVX2Ops
+    {
+        using V = __m256;
+        using M = __m256;
+        using I = __m256i;
+        static constexpr int width = 8;
+
+        static V set(float x) { return _mm256_set1_ps(x); }
+        static V load(const float* p) { return _mm256_loadu_ps(p); }
+        static void store(float* p, V v) { _mm256_storeu_ps(p, v); }
+
+        static void loadComplex(const float* p, V& re, V& im)
+        {
+            // Shuffles work within 128-bit lanes, so the pairs come out as
+            // 0 1 4 5 | 2 3 6 7 and need one cross-lane permute
+            const V a = _mm256_loadu_ps(p);
+            const V b = _mm256_loadu_ps(p + 8);
+            re = reorder(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+            im = reorder(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+        }
+
+        static void storeComplex(float* p, V re, V im)
+        {
+            const V lo = _mm256_unpacklo_ps(re, im);  // 0 1 | 4 5
+            const V hi = _mm256_unpackhi_ps(re, im);  // 2 3 | 6 7
+            _mm256_storeu_ps(p, _mm256_permute2f128_ps(lo, hi, 0x20));
+            _mm256_storeu_ps(p + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+        }
+
+        static V add(V a, V b) { return _mm256_add_ps(a, b); }
+        static V sub(V a, V b) { return _mm256_sub_ps(a, b); }
+        static V mul(V a, V b) { return _mm256_mul_ps(a, b); }
+        static V div(V a, V b) { return _mm256_div_ps(a, b); }
+        static V sqrt(V a) { return _mm256_sqrt_ps(a); }
+        static V min(V a, V b) { return _mm256_min_ps(a, b); }
+        static V max(V a, V b) { return _mm256_max_ps(a, b); }
+        static V abs(V a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+
+        static float sum(V a)
+        {
+            return SSE2Ops::sum(_mm_add_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1)));
+        }
+
+        static M greater(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+        static M less(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+        static V select(M m, V a, V b) { return _mm256_blendv_ps(b, a, m); }
+
+        static I roundToInt(V a) { return _mm256_cvtps_epi32(a); }
+        static V toFloat(I a) { return _mm256_cvtepi32_ps(a); }
+        static I addInt(I a, int b) { return _mm256_add_epi32(a, _mm256_set1_epi32(b)); }
+        static M hasBit(I a, int bit)
+        {
+            const I b = _mm256_set1_epi32(bit);
+            return _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(a, b), b));
+        }
+
+        static I indices(int start) { return _mm256_add_epi32(_mm256_set1_epi32(start), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)); }
+        static I xorInt(I a, I b) { return _mm256_xor_si256(a, b); }
+        static I mulInt(I a, unsigned int b) { return _mm256_mullo_epi32(a, _mm256_set1_epi32(static_cast<int>(b))); }
+        template <int bits> static I shiftRight(I a) { return _mm256_srli_epi32(a, bits); }
+
+    private:
+        static V reorder(V v)
+        {
+            return _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(v), _MM_SHUFFLE(3, 1, 2, 0)));
+        }
+    };
+   #endif
+
+   #if RIPPLE_SIMD_NEON
+    struct NEONOps
+    {
+        using V = float32x4_t;
+        using M = uint32x4_t;
+        using I = int32x4_t;
+        static constexpr int width = 4;
+
+        static V set(float x) { return vdupq_n_f32(x); }
+        static V load(const float* p) { return vld1q_f32(p); }
+        static void store(float* p, V v) { vst1q_f32(p, v); }
+
+        static void loadComplex(const float* p, V& re, V& im)
+        {
+            const float32x4x2_t v = vld2q_f32(p);
+            re = v.val[0];
+            im = v.val[1];
+        }
+
+        static void storeComplex(float* p, V re, V im)
+        {
+            float32x4x2_t v;
+            v.val[0] = re;
+            v.val[1] = im;
+            vst2q_f32(p, v);
+        }
+
+        static V add(V a, V b) { return vaddq_f32(a, b); }
+        static V sub(V a, V b) { return vsubq_f32(a, b); }
+        static V mul(V a, V b) { return vmulq_f32(a, b); }
+        static V div(V a, V b) { return vdivq_f32(a, b); }
+        static V sqrt(V a) { return vsqrtq_f32(a); }
+        static V min(V a, V b) { return vminq_f32(a, b); }
+        static V max(V a, V b) { return vmaxq_f32(a, b); }
+        static V abs(V a) { return vabsq_f32(a); }
+        static float sum(V a) { return vaddvq_f32(a); }
+
+        static M greater(V a, V b) { return vcgtq_f32(a, b); }
+        static M less(V a, V b) { return vcltq_f32(a, b); }
+        static V select(M m, V a, V b) { return vbslq_f32(m, a, b); }
+
+        static I roundToInt(V a) { return vcvtnq_s32_f32(a); }
+        static V toFloat(I a) { return vcvtq_f32_s32(a); }
+        static I addInt(I a, int b) { return vaddq_s32(a, vdupq_n_s32(b)); }
+        static M hasBit(I a, int bit) { return vtstq_s32(a, vdupq_n_s32(bit)); }
+
+        static I indices(int start)
+        {
+            static const int32_t offsets[4] = { 0, 1, 2, 3 };
+            return vaddq_s32(vdupq_n_s32(start), vld1q_s32(offsets));
+        }
+
+        static I xorInt(I a, I b) { return veorq_s32(a, b); }
+        static I mulInt(I a, unsigned int b) { return vmulq_s32(a, vdupq_n_s32(static_cast<int32_t>(b))); }
+        template <int bits> static I shiftRight(I a) { return vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(a), bits)); }
+    };
+   #endif
+
+    // Spin-wait hint: eases off the core without handing it to the scheduler
+    inline void pause()
+    {
+       #if RIPPLE_SIMD_SSE2
+        _mm_pause();
+       #elif RIPPLE_SIMD_NEON && defined(_MSC_VER)
+        __yield();
+       #elif RIPPLE_SIMD_NEON
+        __asm__ __volatile__("yield");
+       #endif
+    }
+
+   #if RIPPLE_SIMD_AVX2
+    using VectorOps = AVX2Ops;
+    inline constexpr const char* instructionSetName = "AVX2";
+   #elif RIPPLE_SIMD_SSE2
+    using VectorOps = SSE2Ops;
+    inline constexpr const char* instructionSetName = "SSE2";
+   #elif RIPPLE_SIMD_NEON
+    using VectorOps = NEONOps;
+    inline constexpr const char* instructionSetName = "NEON";
+   #else
+    using VectorOps = ScalarOps;
+    inline constexpr const char* instructionSetName = "Scalar";
+   #endif
+}
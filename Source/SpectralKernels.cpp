@@ -0,0 +1,324 @@
+/*
+  ==============================================================================
+    RIPPLE - Spectral Kernels Implementation
+    Each kernel is written once against the vector operations in SimdOps.h and
+    instantiated for the compiled instruction set. Leftover bins that don't
+    fill a whole vector go through the scalar operations, which use the same
+    polynomials.
+  ==============================================================================
+*/
+
+#include "SpectralKernels.h"
+#include "SimdOps.h"
+
+namespace SpectralKernels
+{
+    namespace
+    {
+        constexpr float pi = 3.14159265358979323846f;
+        constexpr float halfPi = pi * 0.5f;
+        constexpr float quarterPi = pi * 0.25f;
+        constexpr float twoOverPi = 2.0f / pi;
+
+        // Below this a bin counts as silent (avoids dividing by denormals)
+        constexpr float silentMagnitude = 1.0e-30f;
+
+        using namespace SimdOps;
+
+        //==============================================================================
+        // Runs fn(ops, i) over whole vectors, then the leftovers one at a time.
+        // AVX2 builds take a leftover run of four through SSE2 first.
+        template <typename Fn>
+        inline void forEachGroup(int count, Fn&& fn)
+        {
+            int i = 0;
+
+            if constexpr (VectorOps::width > 1)
+                for (; i + VectorOps::width <= count; i += VectorOps::width)
+                    fn(VectorOps {}, i);
+
+           #if RIPPLE_SIMD_AVX2
+            if (i + SSE2Ops::width <= count)
+            {
+                fn(SSE2Ops {}, i);
+                i += SSE2Ops::width;
+            }
+           #endif
+
+            for (; i < count; ++i)
+                fn(ScalarOps {}, i);
+        }
+
+        // atan2 via the Cephes atanf polynomial on [0, tan(pi/8)] after
+        // folding the octant; arg(0) = 0
+        template <typename Ops>
+        inline typename Ops::V atan2Approx(typename Ops::V y, typename Ops::V x)
+        {
+            using V = typename Ops::V;
+
+            const V ax = Ops::abs(x);
+            const V ay = Ops::abs(y);
+            V t = Ops::div(Ops::min(ax, ay), Ops::max(Ops::max(ax, ay), Ops::set(silentMagnitude)));
+
+            const auto upperHalf = Ops::greater(t, Ops::set(0.41421356f));
+            t = Ops::select(upperHalf, Ops::div(Ops::sub(t, Ops::set(1.0f)), Ops::add(t, Ops::set(1.0f))), t);
+            const V base = Ops::select(upperHalf, Ops::set(quarterPi), Ops::set(0.0f));
+
+            const V z = Ops::mul(t, t);
+            V poly = Ops::set(8.05374449538e-2f);
+            poly = Ops::add(Ops::mul(poly, z), Ops::set(-1.38776856032e-1f));
+            poly = Ops::add(Ops::mul(poly, z), Ops::set(1.99777106478e-1f));
+            poly = Ops::add(Ops::mul(poly, z), Ops::set(-3.33329491539e-1f));
+            V r = Ops::add(base, Ops::add(Ops::mul(Ops::mul(poly, z), t), t));
+
+            r = Ops::select(Ops::greater(ay, ax), Ops::sub(Ops::set(halfPi), r), r);
+            r = Ops::select(Ops::less(x, Ops::set(0.0f)), Ops::sub(Ops::set(pi), r), r);
+            return Ops::select(Ops::less(y, Ops::set(0.0f)), Ops::sub(Ops::set(0.0f), r), r);
+        }
+
+        // sin and cos together: quadrant reduction with a three-part pi/2
+        // (Cody-Waite), then the Cephes sinf/cosf polynomials on [-pi/4, pi/4]
+        template <typename Ops>
+        inline void sinCosApprox(typename Ops::V x, typename Ops::V& sinOut, typename Ops::V& cosOut)
+        {
+            using V = typename Ops::V;
+
+            const auto quadrant = Ops::roundToInt(Ops::mul(x, Ops::set(twoOverPi)));
+            const V q = Ops::toFloat(quadrant);
+
+            V y = Ops::sub(x, Ops::mul(q, Ops::set(1.5703125f)));
+            y = Ops::sub(y, Ops::mul(q, Ops::set(4.837512969970703125e-4f)));
+            y = Ops::sub(y, Ops::mul(q, Ops::set(7.54978995489188216e-8f)));
+            const V z = Ops::mul(y, y);
+
+            V s = Ops::set(-1.9515295891e-4f);
+            s = Ops::add(Ops::mul(s, z), Ops::set(8.3321608736e-3f));
+            s = Ops::add(Ops::mul(s, z), Ops::set(-1.6666654611e-1f));
+            s = Ops::add(Ops::mul(Ops::mul(s, z), y), y);
+
+            V c = Ops::set(2.443315711809948e-5f);
+            c = Ops::add(Ops::mul(c, z), Ops::set(-1.388731625493765e-3f));
+            c = Ops::add(Ops::mul(c, z), Ops::set(4.166664568298827e-2f));
+            c = Ops::add(Ops::mul(Ops::mul(c, z), z), Ops::sub(Ops::set(1.0f), Ops::mul(z, Ops::set(0.5f))));
+
+            // Odd quadrants swap sin and cos; sin is negative in quadrants 2-3, cos in 1-2
+            const auto swap = Ops::hasBit(quadrant, 1);
+            const V sinBase = Ops::select(swap, c, s);
+            const V cosBase = Ops::select(swap, s, c);
+
+            sinOut = Ops::select(Ops::hasBit(quadrant, 2), Ops::sub(Ops::set(0.0f), sinBase), sinBase);
+            cosOut = Ops::select(Ops::hasBit(Ops::addInt(quadrant, 1), 2), Ops::sub(Ops::set(0.0f), cosBase), cosBase);
+        }
+
+        // lowbias32 (Chris Wellons): every input bit flips about half the
+        // output bits, so consecutive counters give unrelated values
+        template <typename Ops>
+        inline typename Ops::I hashInt(typename Ops::I x)
+        {
+            x = Ops::xorInt(x, Ops::template shiftRight<16>(x));
+            x = Ops::mulInt(x, 0x7feb352du);
+            x = Ops::xorInt(x, Ops::template shiftRight<15>(x));
+            x = Ops::mulInt(x, 0x846ca68bu);
+            return Ops::xorInt(x, Ops::template shiftRight<16>(x));
+        }
+    }
+
+    //==============================================================================
+    const char* getInstructionSetName()
+    {
+        return instructionSetName;
+    }
+
+    void magnitude(const float* bins, float* magnitudes, int numBins)
+    {
+        forEachGroup(numBins, [=](auto ops, int i)
+        {
+            using Ops = decltype(ops);
+            typename Ops::V re, im;
+            Ops::loadComplex(bins + i * 2, re, im);
+            Ops::store(magnitudes + i, Ops::sqrt(Ops::add(Ops::mul(re, re), Ops::mul(im, im))));
+        });
+    }
+
+    void magnitudeAndPhase(const float* bins, float* magnitudes, float* phases, int numBins)
+    {
+        forEachGroup(numBins, [=](auto ops, int i)
+        {
+            using Ops = decltype(ops);
+            typename Ops::V re, im;
+            Ops::loadComplex(bins + i * 2, re, im);
+            Ops::store(magnitudes + i, Ops::sqrt(Ops::add(Ops::mul(re, re), Ops::mul(im, im))));
+            Ops::store(phases + i, atan2Approx<Ops>(im, re));
+        });
+    }
+
+    void polarToComplex(const float* magnitudes, const float* phases, const float* phaseOffsets,
+                        float* bins, int numBins)
+    {
+        forEachGroup(numBins, [=](auto ops, int i)
+        {
+            using Ops = decltype(ops);
+            typename Ops::V angle = Ops::load(phases + i);
+            if (phaseOffsets != nullptr)
+                angle = Ops::add(angle, Ops::load(phaseOffsets + i));
+
+            typename Ops::V s, c;
+            sinCosApprox<Ops>(angle, s, c);
+
+            const auto mag = Ops::load(magnitudes + i);
+            Ops::storeComplex(bins + i * 2, Ops::mul(mag, c), Ops::mul(mag, s));
+        });
+    }
+
+    void rescale(float* bins, const float* currentMagnitudes, const float* targetMagnitudes, int numBins)
+    {
+        forEachGroup(numBins, [=](auto ops, int i)
+        {
+            using Ops = decltype(ops);
+            typename Ops::V re, im;
+            Ops::loadComplex(bins + i * 2, re, im);
+
+            const auto current = Ops::load(currentMagnitudes + i);
+            const auto target = Ops::load(targetMagnitudes + i);
+            const auto audible = Ops::greater(current, Ops::set(silentMagnitude));
+            const auto gain = Ops::div(target, Ops::max(current, Ops::set(silentMagnitude)));
+
+            Ops::storeComplex(bins + i * 2,
+                              Ops::select(audible, Ops::mul(re, gain), target),
+                              Ops::select(audible, Ops::mul(im, gain), Ops::set(0.0f)));
+        });
+    }
+
+    void rotate(float* bins, const float* cosines, const float* sines, int numBins)
+    {
+        forEachGroup(numBins, [=](auto ops, int i)
+        {
+            using Ops = decltype(ops);
+            typename Ops::V re, im;
+            Ops::loadComplex(bins + i * 2, re, im);
+
+            const auto c = Ops::load(cosines + i);
+            const auto s = Ops::load(sines + i);
+            Ops::storeComplex(bins + i * 2,
+                              Ops::sub(Ops::mul(re, c), Ops::mul(im, s)),
+                              Ops::add(Ops::mul(re, s), Ops::mul(im, c)));
+        });
+    }
+
+    void sinCos(const float* angles, float* sines, float* cosines, int count)
+    {
+        forEachGroup(count, [=](auto ops, int i)
+        {
+            using Ops = decltype(ops);
+            typename Ops::V s, c;
+            sinCosApprox<Ops>(Ops::load(angles + i), s, c);
+            Ops::store(sines + i, s);
+            Ops::store(cosines + i, c);
+        });
+    }
+
+    void magnitudeRecurrences(const float* input, float* feedbackState, float* frozenState, float* smearState,
+                              float* output, const Recurrences& r, int numBins)
+    {
+        // The switches are per frame, so every group takes the same branches
+        const bool feedbackOn = r.feedback > 0.0f;
+        const bool freezeOn = r.freeze > 0.0f;
+        const bool smearOn = r.smear > 0.0f;
+
+        const float smearGain = r.smear * 0.9f;
+
+        forEachGroup(numBins, [=](auto ops, int i)
+        {
+            using Ops = decltype(ops);
+            using V = typename Ops::V;
+
+            V mag = Ops::load(input + i);
+            V feedback = Ops::load(feedbackState + i);
+
+            if (feedbackOn)
+            {
+                mag = Ops::add(mag, Ops::mul(Ops::mul(feedback, Ops::set(r.feedback)), Ops::set(0.8f)));
+                feedback = Ops::add(Ops::mul(feedback, Ops::set(r.feedbackDecay)), Ops::mul(mag, Ops::set(1.0f - r.feedbackDecay)));
+            }
+            else
+            {
+                feedback = Ops::mul(feedback, Ops::set(r.feedbackRelease));
+            }
+
+            Ops::store(feedbackState + i, feedback);
+
+            if (freezeOn)
+            {
+                const V frozen = Ops::add(Ops::mul(Ops::load(frozenState + i), Ops::set(1.0f - r.captureRate)),
+                                          Ops::mul(mag, Ops::set(r.captureRate)));
+                Ops::store(frozenState + i, frozen);
+                mag = Ops::add(Ops::mul(mag, Ops::set(1.0f - r.freeze)), Ops::mul(frozen, Ops::set(r.freeze)));
+            }
+
+            V smear = Ops::load(smearState + i);
+
+            if (smearOn)
+            {
+                smear = Ops::max(Ops::mul(smear, Ops::set(r.smearDecay)), mag);
+                mag = Ops::add(Ops::mul(mag, Ops::set(1.0f - smearGain)), Ops::mul(Ops::mul(smear, Ops::set(r.smear)), Ops::set(0.9f)));
+            }
+            else
+            {
+                smear = Ops::mul(smear, Ops::set(r.smearRelease));
+            }
+
+            Ops::store(smearState + i, smear);
+            Ops::store(output + i, mag);
+        });
+    }
+
+    void lfoWaveforms(const float* phases, const float* shapes, const float* held, float* values, int count)
+    {
+        forEachGroup(count, [=](auto ops, int i)
+        {
+            using Ops = decltype(ops);
+            using V = typename Ops::V;
+
+            const V p = Ops::load(phases + i);
+            const V shape = Ops::load(shapes + i);
+            const V one = Ops::set(1.0f);
+
+            V sine, unused;
+            sinCosApprox<Ops>(Ops::mul(p, Ops::set(2.0f * pi)), sine, unused);
+
+            // Triangle starting at 0 and rising, like the sine
+            V t = Ops::sub(Ops::mul(p, Ops::set(4.0f)), one);
+            t = Ops::select(Ops::greater(t, Ops::set(2.0f)), Ops::sub(t, Ops::set(4.0f)), t);
+            const V triangle = Ops::sub(one, Ops::abs(t));
+
+            const V square = Ops::select(Ops::less(p, Ops::set(0.5f)), one, Ops::set(-1.0f));
+            const V sawUp = Ops::sub(Ops::mul(p, Ops::set(2.0f)), one);
+
+            V v = Ops::load(held + i);
+            v = Ops::select(Ops::less(shape, Ops::set(4.5f)), Ops::sub(Ops::set(0.0f), sawUp), v);
+            v = Ops::select(Ops::less(shape, Ops::set(3.5f)), sawUp, v);
+            v = Ops::select(Ops::less(shape, Ops::set(2.5f)), square, v);
+            v = Ops::select(Ops::less(shape, Ops::set(1.5f)), triangle, v);
+            v = Ops::select(Ops::less(shape, Ops::set(0.5f)), sine, v);
+            Ops::store(values + i, v);
+        });
+    }
+
+    void noise(unsigned int seed, unsigned int counter, float amount, float* values, int count)
+    {
+        const int key = hashInt<ScalarOps>(static_cast<int>(static_cast<unsigned int>(hashInt<ScalarOps>(static_cast<int>(counter)))
+                                                            ^ (seed * 0x9e3779b9u)));
+
+        forEachGroup(count, [=](auto ops, int i)
+        {
+            using Ops = decltype(ops);
+            using V = typename Ops::V;
+
+            // Top 24 bits to [-1, 1): exact in every instruction set, so the
+            // only rounding is the final scale
+            const auto bits = Ops::template shiftRight<8>(hashInt<Ops>(Ops::addInt(Ops::indices(i), key)));
+            const V unit = Ops::sub(Ops::mul(Ops::toFloat(bits), Ops::set(1.0f / 8388608.0f)), Ops::set(1.0f));
+            Ops::store(values + i, Ops::mul(unit, Ops::set(amount)));
+        });
+    }
+}
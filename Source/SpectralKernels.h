@@ -0,0 +1,73 @@
+/*
+  ==============================================================================
+    RIPPLE - Spectral Kernels
+    Vectorised polar/rectangular conversions for the STFT bins, plus the
+    per-bin effect recurrences, the control-rate LFO waveforms and the
+    seeded noise behind scatter
+
+    Bins are interleaved (re, im) pairs, as produced by
+    juce::dsp::FFT::performRealOnlyForwardTransform. The instruction set is
+    chosen at compile time: AVX2 when the build enables it, SSE2 on x86-64,
+    NEON on ARM64, plain C++ otherwise. Every variant uses the same
+    approximations, so results only differ by float rounding.
+
+    Error bounds (measured over the full input range):
+      magnitude  - exact (IEEE square root)
+      phase      - |error| < 4e-7 rad
+      sin / cos  - |error| < 3e-7 for angles within +-4 pi
+  ==============================================================================
+*/
+
+#pragma once
+
+namespace SpectralKernels
+{
+    // Name of the compiled instruction set ("AVX2", "SSE2", "NEON", "Scalar")
+    const char* getInstructionSetName();
+
+    // magnitudes[i] = |bins[i]|
+    void magnitude(const float* bins, float* magnitudes, int numBins);
+
+    // magnitudes[i] = |bins[i]|, phases[i] = arg(bins[i]) in [-pi, pi], arg(0) = 0
+    void magnitudeAndPhase(const float* bins, float* magnitudes, float* phases, int numBins);
+
+    // bins[i] = magnitudes[i] * e^(j * (phases[i] + phaseOffsets[i])).
+    // phaseOffsets may be null.
+    void polarToComplex(const float* magnitudes, const float* phases, const float* phaseOffsets,
+                        float* bins, int numBins);
+
+    // Polar-free resynthesis: rescales bins[i] from currentMagnitudes[i] to
+    // targetMagnitudes[i] while keeping its phase. Silent bins come back with
+    // phase 0, the same as a polar round trip through atan2(0, 0).
+    void rescale(float* bins, const float* currentMagnitudes, const float* targetMagnitudes, int numBins);
+
+    // bins[i] *= cosines[i] + j * sines[i]
+    void rotate(float* bins, const float* cosines, const float* sines, int numBins);
+
+    // sines[i] = sin(angles[i]), cosines[i] = cos(angles[i])
+    void sinCos(const float* angles, float* sines, float* cosines, int count);
+
+    // One frame of the per-bin magnitude recurrences, in a single pass:
+    // output[i] = input[i] through feedback, freeze and smear, updating each
+    // effect's state run in place. An amount of 0 turns the effect off; off,
+    // feedback and smear release their state, freeze leaves it as it is.
+    struct Recurrences
+    {
+        float feedback = 0.0f, feedbackDecay = 1.0f, feedbackRelease = 1.0f;
+        float freeze = 0.0f, captureRate = 0.0f;
+        float smear = 0.0f, smearDecay = 1.0f, smearRelease = 1.0f;
+    };
+
+    void magnitudeRecurrences(const float* input, float* feedbackState, float* frozenState, float* smearState,
+                              float* output, const Recurrences& recurrences, int numBins);
+
+    // values[i] = LFO waveform shapes[i] at phases[i] (0..1), bipolar -1..1.
+    // Shapes follow LFOShapes: 0 sine, 1 triangle, 2 square, 3 saw up,
+    // 4 saw down, 5 random (sample and hold, returns held[i]).
+    void lfoWaveforms(const float* phases, const float* shapes, const float* held, float* values, int count);
+
+    // values[i] = amount * uniform noise in [-1, 1), from a hash of (seed,
+    // counter, i) rather than a running generator: the same arguments give
+    // the same values on every run and every instruction set.
+    void noise(unsigned int seed, unsigned int counter, float amount, float* values, int count);
+}
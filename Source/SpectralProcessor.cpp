@@ -7,285 +7,1040 @@
 */
 
 #include "SpectralProcessor.h"
+#include "SpectralKernels.h"
+#include "ModulationEngine.h"
+#include "SimdOps.h"
 #include <cmath>
 #include <cstring>
+#include <thread>
+
+namespace
+{
+    // Input below this counts as silence, and effect state below it (relative
+    // to full scale) as decayed: -120 dB
+    constexpr float silenceThreshold = 1.0e-6f;
+
+    // juce::SpinLock hands the core back to the scheduler once it has spun
+    // for a while, a system call the audio thread can't make while it waits
+    // out a worker's frame. This one only spins.
+    struct ScopedSpinLock
+    {
+        explicit ScopedSpinLock(const juce::SpinLock& spinLock) : lock(spinLock)
+        {
+            while (!lock.tryEnter())
+                SimdOps::pause();
+        }
+
+        ~ScopedSpinLock() { lock.exit(); }
+
+        const juce::SpinLock& lock;
+    };
+}
+
+// Only the outermost scope moves the sequence: setFrameSize() and prepare()
+// rebuild the configuration around a reset() that is scoped as well
+struct SpectralProcessor::FrozenWriteScope
+{
+    explicit FrozenWriteScope(SpectralProcessor& owner) : processor(owner)
+    {
+        if (processor.frozenWriteDepth++ == 0)
+        {
+            processor.frozenSequence.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+    }
+
+    ~FrozenWriteScope()
+    {
+        if (--processor.frozenWriteDepth == 0)
+            processor.frozenSequence.fetch_add(1, std::memory_order_release);
+    }
+
+    SpectralProcessor& processor;
+};
+
+const std::array<SpectralProcessor::FrameKernel, SpectralProcessor::NUM_FFT_SIZES> SpectralProcessor::frameKernels {
+    &SpectralProcessor::transformFrame<8>,
+    &SpectralProcessor::transformFrame<9>,
+    &SpectralProcessor::transformFrame<10>,
+    &SpectralProcessor::transformFrame<11>,
+    &SpectralProcessor::transformFrame<12>,
+    &SpectralProcessor::transformFrame<13>
+};
 
 SpectralProcessor::SpectralProcessor()
 {
-    for (int i = 0; i < NUM_BINS; ++i)
+    // All FFT engines are built up front so size changes never allocate
+    for (int i = 0; i < NUM_FFT_SIZES; ++i)
+        ffts[i] = std::make_unique<juce::dsp::FFT>(MIN_FFT_ORDER + i);
+
+    setFrameSize(DEFAULT_FFT_ORDER, DEFAULT_OVERLAP);
+}
+
+SpectralProcessor::~SpectralProcessor()
+{
+    if (pool != nullptr)
+        pool->remove(registeredEntry);
+}
+
+void SpectralProcessor::prepare(double newSampleRate, int maxBlockSize)
+{
+    discardQueuedFrames();
+    const FrozenWriteScope frozenWrite(*this);
+
+    sampleRate = newSampleRate;
+    preparedBlockSize = juce::jmax(1, maxBlockSize);
+
+    // Room for the deepest pipeline: a block's worth of hops at the shortest
+    // hop, each slot a frame per channel (a block at 8x overlap plus a frame)
+    constexpr int minHopSize = (1 << MIN_FFT_ORDER) / 8;
+    pipelineFrames.assign(static_cast<size_t>((preparedBlockSize * 8 + MAX_FFT_SIZE) * MAX_CHANNELS), 0.0f);
+    pipelineParameters.resize(static_cast<size_t>(preparedBlockSize / minHopSize + 1));
+
+    configurePipeline();
+    reset();
+}
+
+int SpectralProcessor::getAutoFFTOrder(double rate)
+{
+    // 1024 points at 44.1/48 kHz, one octave more per doubling of the rate
+    const int octaves = static_cast<int>(std::round(std::log2(rate / 48000.0)));
+    return juce::jlimit(MIN_FFT_ORDER, MAX_FFT_ORDER, DEFAULT_FFT_ORDER + octaves);
+}
+
+void SpectralProcessor::setFrameSize(int newFftOrder, int newOverlap)
+{
+    newFftOrder = juce::jlimit(MIN_FFT_ORDER, MAX_FFT_ORDER, newFftOrder);
+    newOverlap = newOverlap <= 2 ? 2 : (newOverlap >= 8 ? 8 : 4);
+
+    if (frameKernel != nullptr && newFftOrder == fftOrder && newOverlap == overlap)
+        return;
+
+    discardQueuedFrames();
+    const FrozenWriteScope frozenWrite(*this);
+
+    fftOrder = newFftOrder;
+    fftSize = 1 << fftOrder;
+    numBins = fftSize / 2 + 1;
+    overlap = newOverlap;
+    hopSize = fftSize / overlap;
+    frameKernel = frameKernels[fftOrder - MIN_FFT_ORDER];
+    hopTimeScale = static_cast<float>(hopSize) / 256.0f;
+
+    // Rebuild the windows in place. Squared Hann averages 3/8 and Hann
+    // (sqrt-Hann squared) averages 1/2, times the number of overlapping frames.
+    juce::dsp::WindowingFunction<float>::fillWindowingTables(analysisWindow.data(), static_cast<size_t>(fftSize + 1),
+                                                             juce::dsp::WindowingFunction<float>::hann, false);
+    float windowCorrection;
+    if (overlap == 2)
     {
-        visualMagnitude[i].store(0.0f);
-        visualFrozen[i].store(0.0f);
+        for (int i = 0; i <= fftSize; ++i)
+            analysisWindow[i] = std::sqrt(analysisWindow[i]);
+        windowCorrection = 1.0f / (overlap * 0.5f);
     }
+    else
+    {
+        windowCorrection = 1.0f / (overlap * 0.375f);
+    }
+
+    juce::FloatVectorOperations::copyWithMultiply(synthesisWindow.data(), analysisWindow.data(),
+                                                  windowCorrection, fftSize);
+
+    configurePipeline();
     reset();
 }
 
-void SpectralProcessor::prepare(double newSampleRate, int)
+void SpectralProcessor::setPipelined(bool shouldPipeline)
 {
-    sampleRate = newSampleRate;
+    if (shouldPipeline == pipelined)
+        return;
+
+    discardQueuedFrames();
+    pipelined = shouldPipeline;
+
+    if (!pipelined)
+        releasePoolEntry();
+
+    configurePipeline();
     reset();
 }
 
-void SpectralProcessor::reset()
+void SpectralProcessor::updatePoolMembership(bool shouldBeMember)
 {
-    inputFifo.fill(0.0f);
-    outputFifo.fill(0.0f);
+    if (shouldBeMember)
+    {
+        // The first member creates the pool and its threads
+        if (pool == nullptr)
+        {
+            pool = FramePool::getInstance();
+            registeredEntry = pool->add(*this);
+            idleEntry.store(registeredEntry);
+        }
+
+        return;
+    }
+
+    // Leaves only once the audio thread has handed the entry back; the last
+    // member to leave shuts the pool down
+    if (pool != nullptr && idleEntry.exchange(nullptr) == registeredEntry)
+    {
+        pool->remove(registeredEntry);
+        registeredEntry = nullptr;
+        pool.reset();
+    }
+}
+
+void SpectralProcessor::takePoolEntry()
+{
+    if (auto* entry = idleEntry.exchange(nullptr))
+    {
+        const ScopedSpinLock lock(frameLock);
+        poolEntry = entry;
+        publishDeadline();
+    }
+}
+
+void SpectralProcessor::releasePoolEntry()
+{
+    if (poolEntry == nullptr)
+        return;
+
+    const ScopedSpinLock lock(frameLock);
+    poolEntry->deadline.store(FramePool::noDeadline);
+    idleEntry.store(poolEntry);
+    poolEntry = nullptr;
+}
+
+void SpectralProcessor::configurePipeline()
+{
+    // Frames are collected at least a host block after they were queued, so
+    // never in the callback that queued them
+    pipelineDepth = pipelined && !pipelineFrames.empty() ? (preparedBlockSize + hopSize - 1) / hopSize : 0;
+    deadlineTicks = static_cast<juce::int64>(pipelineDepth * hopSize / sampleRate
+                                             * static_cast<double>(juce::Time::getHighResolutionTicksPerSecond()));
+}
+
+void SpectralProcessor::ChannelState::reset()
+{
+    inputBuffer.fill(0.0f);
+    outputBuffer.fill(0.0f);
     fftData.fill(0.0f);
     magnitude.fill(0.0f);
     phase.fill(0.0f);
+    outputMagnitude.fill(0.0f);
     frozenMagnitude.fill(0.0f);
-    frozenPhase.fill(0.0f);
     smearBuffer.fill(0.0f);
     feedbackBuffer.fill(0.0f);
+}
+
+void SpectralProcessor::reset()
+{
+    discardQueuedFrames();
+    const FrozenWriteScope frozenWrite(*this);
+
+    for (auto& state : channels)
+        state.reset();
+
     shiftedMagnitude.fill(0.0f);
+    shapedMagnitude.fill(0.0f);
+    tiltGain.fill(1.0f);
+    phaseNoise.fill(0.0f);
+    noiseSin.fill(0.0f);
+    noiseCos.fill(1.0f);
+    linkedMagnitude.fill(0.0f);
+    shiftMapBins = 0;
+    tiltGainBins = 0;
 
-    fifoPos = 0;
-    frameCount = 0;
+    inputPos = fftSize;
+    outputPos = 0;
+    hopPos = 0;
+    quietSamples = 0;
+    frameIndex = 0;
+    settled.store(false);
 }
 
-void SpectralProcessor::processFrame()
+template <int Order>
+void SpectralProcessor::transformFrame(const float* const* input, const FrameParameters& parameters)
 {
-    float* fftPtr = fftData.data();
-    const float* inputPtr = inputFifo.data();
+    constexpr int size = 1 << Order;
+    auto& fft = *ffts[Order - MIN_FFT_ORDER];
+    frameChannels = parameters.numChannels;
 
-    // Step 1: Copy circular FIFO to FFT buffer (unwrap the ring buffer)
-    std::memcpy(fftPtr, inputPtr + fifoPos, (FFT_SIZE - fifoPos) * sizeof(float));
-    if (fifoPos > 0)
+    // Step 1: Window the frame into the FFT buffer
+    // Step 2: Forward FFT
+    for (int ch = 0; ch < frameChannels; ++ch)
     {
-        std::memcpy(fftPtr + FFT_SIZE - fifoPos, inputPtr, fifoPos * sizeof(float));
+        float* fftPtr = channels[ch].fftData.data();
+
+        juce::FloatVectorOperations::multiply(fftPtr, input[ch], analysisWindow.data(), size);
+        fft.performRealOnlyForwardTransform(fftPtr, true);
     }
 
-    // Step 2: Apply window before FFT
-    window.multiplyWithWindowingTable(fftPtr, FFT_SIZE);
+    // Step 3: Process spectrum (extract magnitudes for visualization, apply effects)
+    processSpectrum(parameters);
 
-    // Step 3: Forward FFT
-    fft.performRealOnlyForwardTransform(fftPtr, true);
+    // Step 4: Inverse FFT, the synthesis window is left to the caller
+    for (int ch = 0; ch < frameChannels; ++ch)
+        fft.performRealOnlyInverseTransform(channels[ch].fftData.data());
 
-    // Step 4: Process spectrum (extract magnitudes for visualization, apply effects)
-    processSpectrum();
+    framesProcessed.fetch_add(1, std::memory_order_relaxed);
+}
 
-    // Step 5: Inverse FFT
-    fft.performRealOnlyInverseTransform(fftPtr);
+SpectralProcessor::FrameParameters SpectralProcessor::readFrameParameters()
+{
+    FrameParameters parameters;
+    parameters.freeze = freezeAmount.load();
+    parameters.smear = smearAmount.load();
+    parameters.scatter = scatterAmount.load();
+    parameters.shift = shiftAmount.load();
+    parameters.tilt = tiltAmount.load();
+    parameters.feedback = feedbackAmount.load();
+    parameters.numChannels = numActiveChannels;
+    parameters.linked = stereoLinked.load() && numActiveChannels > 1;
+    parameters.seed = randomSeed.load();
+    parameters.frameIndex = frameIndex++;
+    parameters.inputQuiet = quietSamples >= fftSize;
+
+    // LFO modulation, one step per hop
+    if (modulation != nullptr && modulation->isActive())
+    {
+        modulation->advance(hopSize);
+        parameters.freeze = modulation->apply(ModulationEngine::freeze, parameters.freeze, 0.0f, 1.0f);
+        parameters.smear = modulation->apply(ModulationEngine::smear, parameters.smear, 0.0f, 1.0f);
+        parameters.scatter = modulation->apply(ModulationEngine::scatter, parameters.scatter, 0.0f, 1.0f);
+        parameters.shift = modulation->apply(ModulationEngine::shift, parameters.shift, -1.0f, 1.0f);
+        parameters.tilt = modulation->apply(ModulationEngine::tilt, parameters.tilt, -1.0f, 1.0f);
+        parameters.feedback = modulation->apply(ModulationEngine::feedback, parameters.feedback, 0.0f, 1.0f);
+    }
 
-    // Step 6: Apply window again and gain correction
-    window.multiplyWithWindowingTable(fftPtr, FFT_SIZE);
+    return parameters;
+}
+
+void SpectralProcessor::processSpectrum(const FrameParameters& parameters)
+{
+    const float freeze = parameters.freeze;
+    const float smear = parameters.smear;
+    const float scatter = parameters.scatter;
+    const float shift = parameters.shift;
+    const float tilt = parameters.tilt;
+    const float feedback = parameters.feedback;
+
+    const bool linked = parameters.linked;
+    const int numSpectra = linked ? 1 : frameChannels;
+
+    // Scatter is the only effect that touches phase. Without it the bins are
+    // rescaled in place and no phase is ever computed.
+    const bool applyPhaseNoise = scatter > 0.01f;
+
+    // Extract magnitudes (and phases when needed)
+    if (linked)
+        analyseLinked();
+    else
+        for (int ch = 0; ch < frameChannels; ++ch)
+            analyse(channels[ch], applyPhaseNoise);
+
+    // Shift map and tilt gains are the same for every channel
+    if (std::abs(shift) > 0.01f)
+        updateShiftMap(shift);
+
+    if (std::abs(tilt) > 0.01f)
+        updateTiltGains(tilt);
+
+    // === SCATTER phase noise, shared so the stereo image stays coherent ===
+    if (applyPhaseNoise)
+    {
+        SpectralKernels::noise(parameters.seed, parameters.frameIndex, juce::MathConstants<float>::pi * scatter,
+                               phaseNoise.data(), numBins);
+    }
 
-    // Gain correction: 2/3 for Hann window squared, divided by overlap factor
-    const float gain = windowCorrection;
-    for (int i = 0; i < FFT_SIZE; ++i)
     {
-        fftPtr[i] *= gain;
+        const FrozenWriteScope frozenWrite(*this);
+
+        // A saved session's frozen spectrum, before freeze blends it in
+        if (frozenQueueState.load(std::memory_order_relaxed) == frozenQueued)
+            takeQueuedFrozenSpectrum();
+
+        for (int s = 0; s < numSpectra; ++s)
+            applyEffects(channels[s], linked ? linkedMagnitude.data() : channels[s].magnitude.data(),
+                         freeze, smear, scatter, shift, tilt, feedback);
+
+        // Settling clears the frozen spectrum, so it's a write as well
+        updateSettled(parameters.inputQuiet, numSpectra);
     }
 
-    // Step 7: Overlap-add to output FIFO
-    // The processed frame needs to be added at the correct position
-    for (int i = 0; i < FFT_SIZE; ++i)
+    // Update visualization: raw sums of the processed spectra, the display
+    // curve is applied by the editor on the message thread
+    auto& snapshot = spectrumSnapshots[writeSnapshot];
+    juce::FloatVectorOperations::copy(snapshot.magnitude.data(), channels[0].outputMagnitude.data(), numBins);
+    juce::FloatVectorOperations::copy(snapshot.frozen.data(), channels[0].frozenMagnitude.data(), numBins);
+    for (int s = 1; s < numSpectra; ++s)
     {
-        int outIdx = (fifoPos + i) % FFT_SIZE;
-        outputFifo[outIdx] += fftPtr[i];
+        juce::FloatVectorOperations::add(snapshot.magnitude.data(), channels[s].outputMagnitude.data(), numBins);
+        juce::FloatVectorOperations::add(snapshot.frozen.data(), channels[s].frozenMagnitude.data(), numBins);
     }
+
+    snapshot.numBins = numBins;
+    snapshot.sampleRate = sampleRate;
+    snapshot.scale = 1.0f / (static_cast<float>(fftSize) * static_cast<float>(numSpectra));
+
+    snapshot.sequence = ++spectrumSequence;
+    publishSpectrum();
+
+    // Reconstruct complex values
+    if (linked)
+        resynthesiseLinked(applyPhaseNoise);
+    else
+        for (int ch = 0; ch < frameChannels; ++ch)
+            resynthesise(channels[ch], applyPhaseNoise);
 }
 
-void SpectralProcessor::processSpectrum()
+void SpectralProcessor::updateShiftMap(float shift)
 {
-    float* fftPtr = fftData.data();
+    if (shiftMapBins == numBins && shiftMapAmount == shift)
+        return;
 
-    // Get parameters
-    const float freeze = freezeAmount.load();
-    const float smear = smearAmount.load();
-    const float scatter = scatterAmount.load();
-    const float shift = shiftAmount.load();
-    const float tilt = tiltAmount.load();
-    const float feedback = feedbackAmount.load();
+    // Calculate shift amount in bins (shift of 1 = one octave up)
+    const float shiftRatio = std::pow(2.0f, shift);
 
-    // Temporary arrays for spectral processing
-    std::array<float, NUM_BINS> tempMag;
-    std::array<float, NUM_BINS> tempPhase;
+    // Each bin is split between the two bins around its shifted position.
+    // DC and Nyquist neither move nor receive energy.
+    shiftBegin = numBins;
+    shiftEnd = 1;
 
-    // First pass: extract all magnitudes and phases
-    for (int i = 0; i < NUM_BINS; ++i)
+    for (int i = 1; i < numBins - 1; ++i)
     {
-        float real = fftPtr[i * 2];
-        float imag = fftPtr[i * 2 + 1];
-        tempMag[i] = std::sqrt(real * real + imag * imag);
-        tempPhase[i] = std::atan2(imag, real);
+        const float position = static_cast<float>(i) * shiftRatio;
+        const int target = static_cast<int>(position);
+
+        if (target > 0 && target < numBins - 1)
+        {
+            shiftTarget[i] = target;
+            shiftFraction[i] = target + 1 < numBins - 1 ? position - static_cast<float>(target) : 0.0f;
+            shiftBegin = juce::jmin(shiftBegin, i);
+            shiftEnd = i + 1;
+        }
     }
 
-    // === SHIFT EFFECT (spectral pitch shift) ===
-    if (std::abs(shift) > 0.01f)
-    {
-        shiftedMagnitude.fill(0.0f);
+    shiftMapAmount = shift;
+    shiftMapBins = numBins;
+}
+
+void SpectralProcessor::updateTiltGains(float tilt)
+{
+    if (tiltGainBins == numBins && tiltGainAmount == tilt)
+        return;
 
-        // Calculate shift amount in bins (shift of 1 = one octave up)
-        float shiftRatio = std::pow(2.0f, shift);
+    // === TILT EFFECT (spectral EQ - dark to bright) ===
+    for (int i = 1; i < numBins; ++i)
+    {
+        // Calculate tilt factor based on frequency position
+        float freqNorm = static_cast<float>(i) / numBins;
+        float gain;
 
-        for (int i = 1; i < NUM_BINS - 1; ++i)
+        if (tilt > 0)
         {
-            int newBin = static_cast<int>(i * shiftRatio);
-            if (newBin > 0 && newBin < NUM_BINS - 1)
-            {
-                shiftedMagnitude[newBin] += tempMag[i];
-            }
+            // Positive tilt: boost highs, cut lows
+            gain = 1.0f + tilt * (freqNorm * 2.0f - 1.0f);
         }
-
-        // Blend original with shifted
-        float shiftBlend = std::abs(shift);
-        for (int i = 0; i < NUM_BINS; ++i)
+        else
         {
-            tempMag[i] = tempMag[i] * (1.0f - shiftBlend) + shiftedMagnitude[i] * shiftBlend;
+            // Negative tilt: boost lows, cut highs
+            gain = 1.0f - tilt * (1.0f - freqNorm * 2.0f);
         }
+
+        tiltGain[i] = juce::jlimit(0.2f, 3.0f, gain);
     }
 
-    // === TILT EFFECT (spectral EQ - dark to bright) ===
-    if (std::abs(tilt) > 0.01f)
+    tiltGainAmount = tilt;
+    tiltGainBins = numBins;
+}
+
+void SpectralProcessor::updateSettled(bool inputQuiet, int numSpectra)
+{
+    if (!inputQuiet)
     {
-        for (int i = 1; i < NUM_BINS; ++i)
-        {
-            // Calculate tilt factor based on frequency position
-            float freqNorm = static_cast<float>(i) / NUM_BINS;
-            float tiltGain;
+        settled.store(false, std::memory_order_relaxed);
+        return;
+    }
 
-            if (tilt > 0)
-            {
-                // Positive tilt: boost highs, cut lows
-                tiltGain = 1.0f + tilt * (freqNorm * 2.0f - 1.0f);
-            }
-            else
-            {
-                // Negative tilt: boost lows, cut highs
-                tiltGain = 1.0f - tilt * (1.0f - freqNorm * 2.0f);
-            }
+    // A silent frame settles the processor once what the effects hold has
+    // decayed below the threshold too. From then on silent frames would come
+    // out silent, so they're skipped.
+    const float threshold = silenceThreshold * static_cast<float>(fftSize);
 
-            tiltGain = juce::jlimit(0.2f, 3.0f, tiltGain);
-            tempMag[i] *= tiltGain;
-        }
+    for (int s = 0; s < numSpectra; ++s)
+    {
+        const auto& state = channels[s];
+        if (juce::FloatVectorOperations::findMaximum(state.frozenMagnitude.data(), numBins) >= threshold
+            || juce::FloatVectorOperations::findMaximum(state.smearBuffer.data(), numBins) >= threshold
+            || juce::FloatVectorOperations::findMaximum(state.feedbackBuffer.data(), numBins) >= threshold)
+            return;
     }
 
-    // Process each bin
-    for (int i = 0; i < NUM_BINS; ++i)
+    // Cleared rather than left to decay into denormals
+    for (auto& state : channels)
     {
-        float mag = tempMag[i];
-        float ph = tempPhase[i];
+        juce::FloatVectorOperations::clear(state.frozenMagnitude.data(), numBins);
+        juce::FloatVectorOperations::clear(state.smearBuffer.data(), numBins);
+        juce::FloatVectorOperations::clear(state.feedbackBuffer.data(), numBins);
+    }
 
-        // === FEEDBACK (self-modulation for evolving textures) ===
-        if (feedback > 0.01f)
-        {
-            mag += feedbackBuffer[i] * feedback * 0.8f;
-            feedbackBuffer[i] = feedbackBuffer[i] * 0.95f + mag * 0.05f;
-        }
-        else
+    settled.store(true, std::memory_order_relaxed);
+}
+
+void SpectralProcessor::analyse(ChannelState& state, bool needsPhase)
+{
+    const float* fftPtr = state.fftData.data();
+
+    if (needsPhase)
+        SpectralKernels::magnitudeAndPhase(fftPtr, state.magnitude.data(), state.phase.data(), numBins);
+    else
+        SpectralKernels::magnitude(fftPtr, state.magnitude.data(), numBins);
+}
+
+void SpectralProcessor::analyseLinked()
+{
+    // RMS magnitude across channels: unlike a mid sum it can't cancel out
+    // for out-of-phase material. Phase is left to each channel.
+    const float channelScale = 1.0f / static_cast<float>(frameChannels);
+
+    for (int i = 0; i < numBins; ++i)
+    {
+        float power = 0.0f;
+        for (int ch = 0; ch < frameChannels; ++ch)
         {
-            feedbackBuffer[i] *= 0.9f;
+            float real = channels[ch].fftData[i * 2];
+            float imag = channels[ch].fftData[i * 2 + 1];
+            power += real * real + imag * imag;
         }
 
-        // === FREEZE EFFECT ===
-        if (freeze > 0.01f)
+        linkedMagnitude[i] = std::sqrt(power * channelScale);
+    }
+}
+
+void SpectralProcessor::applyEffects(ChannelState& state, const float* inputMagnitude, float freeze,
+                                     float smear, float scatter, float shift, float tilt, float feedback)
+{
+    // Shift and tilt work on a copy so the analysed magnitude stays intact
+    // for rescaling the bins at resynthesis
+    auto& tempMag = shapedMagnitude;
+    juce::FloatVectorOperations::copy(tempMag.data(), inputMagnitude, numBins);
+
+    // === SHIFT EFFECT (spectral pitch shift, map built in updateShiftMap) ===
+    if (std::abs(shift) > 0.01f)
+    {
+        juce::FloatVectorOperations::clear(shiftedMagnitude.data(), numBins);
+
+        for (int i = shiftBegin; i < shiftEnd; ++i)
         {
-            float captureRate = 0.05f * (1.0f - freeze * 0.95f);
-            frozenMagnitude[i] = frozenMagnitude[i] * (1.0f - captureRate) + mag * captureRate;
-            frozenPhase[i] = ph;
-            mag = mag * (1.0f - freeze) + frozenMagnitude[i] * freeze;
+            const float upper = tempMag[i] * shiftFraction[i];
+            shiftedMagnitude[shiftTarget[i]] += tempMag[i] - upper;
+            shiftedMagnitude[shiftTarget[i] + 1] += upper;
         }
 
-        // === SMEAR/SUSTAIN EFFECT ===
-        if (smear > 0.01f)
+        // Blend original with shifted
+        const float shiftBlend = std::abs(shift);
+        juce::FloatVectorOperations::multiply(tempMag.data(), 1.0f - shiftBlend, numBins);
+        juce::FloatVectorOperations::addWithMultiply(tempMag.data(), shiftedMagnitude.data(), shiftBlend, numBins);
+    }
+
+    // === TILT EFFECT (gains built in updateTiltGains) ===
+    if (std::abs(tilt) > 0.01f)
+        juce::FloatVectorOperations::multiply(tempMag.data() + 1, tiltGain.data() + 1, numBins - 1);
+
+    // Per-frame decay and capture rates, rescaled to the current hop length
+    auto perHop = [this](float rate) { return hopTimeScale == 1.0f ? rate : std::pow(rate, hopTimeScale); };
+    auto captureFor = [this](float rate) { return hopTimeScale == 1.0f ? rate : 1.0f - std::pow(1.0f - rate, hopTimeScale); };
+
+    // === FEEDBACK, FREEZE and SMEAR/SUSTAIN, one vectorised pass over the bins ===
+    SpectralKernels::Recurrences recurrences;
+    recurrences.feedback = feedback > 0.01f ? feedback : 0.0f;   // Self-modulation for evolving textures
+    recurrences.feedbackDecay = perHop(0.95f);
+    recurrences.feedbackRelease = perHop(0.9f);
+    recurrences.freeze = freeze > 0.01f ? freeze : 0.0f;
+    recurrences.captureRate = captureFor(0.05f * (1.0f - freeze * 0.95f));
+    recurrences.smear = smear > 0.01f ? smear : 0.0f;
+    recurrences.smearDecay = perHop(0.85f + smear * 0.145f);  // 0.85 to 0.995 per 256 samples
+    recurrences.smearRelease = perHop(0.8f);
+
+    SpectralKernels::magnitudeRecurrences(tempMag.data(), state.feedbackBuffer.data(), state.frozenMagnitude.data(),
+                                          state.smearBuffer.data(), state.outputMagnitude.data(), recurrences, numBins);
+
+    // === SCATTER/DIFFUSE EFFECT (phase noise is applied at resynthesis) ===
+    if (scatter > 0.01f)
+    {
+        const float blurAmount = scatter * 0.5f;
+        float* output = state.outputMagnitude.data();
+
+        for (int i = 2; i < numBins - 2; ++i)
         {
-            float decayRate = 0.85f + smear * 0.145f;  // 0.85 to 0.995
-            smearBuffer[i] = juce::jmax(smearBuffer[i] * decayRate, mag);
-            mag = mag * (1.0f - smear * 0.9f) + smearBuffer[i] * smear * 0.9f;
+            const float neighborAvg = (tempMag[i-2] + tempMag[i-1] + tempMag[i+1] + tempMag[i+2]) * 0.25f;
+            output[i] = output[i] * (1.0f - blurAmount) + neighborAvg * blurAmount;
         }
-        else
+    }
+}
+
+void SpectralProcessor::resynthesise(ChannelState& state, bool applyPhaseNoise)
+{
+    float* fftPtr = state.fftData.data();
+
+    if (applyPhaseNoise)
+    {
+        SpectralKernels::polarToComplex(state.outputMagnitude.data(), state.phase.data(), phaseNoise.data(),
+                                        fftPtr, numBins);
+    }
+    else
+    {
+        // Magnitude-only effects: scale the bins directly, phase is kept as is
+        SpectralKernels::rescale(fftPtr, state.magnitude.data(), state.outputMagnitude.data(), numBins);
+    }
+}
+
+void SpectralProcessor::resynthesiseLinked(bool applyPhaseNoise)
+{
+    // Scale (and rotate, for scatter) each channel's own bins by the change
+    // the effects made to the shared magnitude
+    const float* processed = channels[0].outputMagnitude.data();
+
+    if (applyPhaseNoise)
+        SpectralKernels::sinCos(phaseNoise.data(), noiseSin.data(), noiseCos.data(), numBins);
+
+    for (int ch = 0; ch < frameChannels; ++ch)
+    {
+        float* fftPtr = channels[ch].fftData.data();
+        SpectralKernels::rescale(fftPtr, linkedMagnitude.data(), processed, numBins);
+
+        if (applyPhaseNoise)
+            SpectralKernels::rotate(fftPtr, noiseCos.data(), noiseSin.data(), numBins);
+    }
+}
+
+void SpectralProcessor::process(juce::AudioBuffer<float>& buffer)
+{
+    numActiveChannels = juce::jmin(buffer.getNumChannels(), static_cast<int>(MAX_CHANNELS));
+
+    if (numActiveChannels == 0)
+        return;
+
+    if (pipelined)
+    {
+        blockStartTicks = juce::Time::getHighResolutionTicks();
+
+        if (poolEntry == nullptr)
+            takePoolEntry();
+    }
+
+    processChannels(buffer.getArrayOfWritePointers(), buffer.getNumSamples());
+
+    // The frames queued in this block are needed from the next one on
+    if (poolEntry != nullptr)
+        pool->notify();
+}
+
+void SpectralProcessor::processChannels(float* const* channelData, int numSamples)
+{
+    // Work in chunks that never cross a hop boundary
+    for (int pos = 0; pos < numSamples;)
+    {
+        const int count = juce::jmin(numSamples - pos, hopSize - hopPos);
+
+        for (int ch = 0; ch < numActiveChannels; ++ch)
         {
-            smearBuffer[i] *= 0.8f;
+            auto& state = channels[ch];
+            float* io = channelData[ch] + pos;
+            float* out = state.outputBuffer.data() + outputPos;
+
+            // Append input to the history, then hand back finished output
+            // and clear it for the next overlap-add
+            juce::FloatVectorOperations::copy(state.inputBuffer.data() + inputPos, io, count);
+            juce::FloatVectorOperations::copy(io, out, count);
+            juce::FloatVectorOperations::clear(out, count);
         }
 
-        // === SCATTER/DIFFUSE EFFECT ===
-        if (scatter > 0.01f)
+        pos += count;
+        inputPos += count;
+        outputPos += count;
+        hopPos += count;
+
+        // Process frame every hopSize samples
+        if (hopPos == hopSize)
         {
-            float phaseNoise = (random.nextFloat() * 2.0f - 1.0f) * juce::MathConstants<float>::pi;
-            ph += phaseNoise * scatter;
+            hopPos = 0;
+            trackInputLevel();
+
+            if (pipelineDepth > 0)
+            {
+                if (framesQueued.load(std::memory_order_relaxed) - framesCollected == pipelineDepth)
+                    collectFrame();
 
-            if (i > 1 && i < NUM_BINS - 2)
+                queueFrame();
+            }
+            else
             {
-                float blurAmount = scatter * 0.5f;
-                float neighborAvg = (tempMag[i-2] + tempMag[i-1] + tempMag[i+1] + tempMag[i+2]) * 0.25f;
-                mag = mag * (1.0f - blurAmount) + neighborAvg * blurAmount;
+                processFrame();
             }
         }
+    }
+}
 
-        // Store magnitude for visualization
-        magnitude[i] = mag;
+void SpectralProcessor::trackInputLevel()
+{
+    float peak = 0.0f;
+    for (int ch = 0; ch < numActiveChannels; ++ch)
+    {
+        const auto range = juce::FloatVectorOperations::findMinAndMax(channels[ch].inputBuffer.data() + inputPos - hopSize,
+                                                                      hopSize);
+        peak = juce::jmax(peak, -range.getStart(), range.getEnd());
+    }
 
-        // Update visualization
-        float displayMag = mag / static_cast<float>(FFT_SIZE);
-        displayMag = std::pow(displayMag, 0.35f);
-        visualMagnitude[i].store(juce::jlimit(0.0f, 1.0f, displayMag * 10.0f));
+    // Counted up to a frame: once the whole analysis window is silent
+    quietSamples = peak < silenceThreshold ? juce::jmin(quietSamples + hopSize, fftSize) : 0;
+}
 
-        float displayFrozen = frozenMagnitude[i] / static_cast<float>(FFT_SIZE);
-        displayFrozen = std::pow(displayFrozen, 0.35f);
-        visualFrozen[i].store(juce::jlimit(0.0f, 1.0f, displayFrozen * 10.0f));
+void SpectralProcessor::processFrame()
+{
+    const FrameParameters parameters = readFrameParameters();
 
-        // Reconstruct complex value
-        fftPtr[i * 2] = mag * std::cos(ph);
-        fftPtr[i * 2 + 1] = mag * std::sin(ph);
+    // Settled and still silent: the frame would come out silent
+    if (parameters.inputQuiet && settled.load(std::memory_order_relaxed))
+    {
+        compactOutput();
+        compactInput();
+        return;
     }
+
+    std::array<const float*, MAX_CHANNELS> input {};
+    std::array<const float*, MAX_CHANNELS> output {};
+    for (int ch = 0; ch < numActiveChannels; ++ch)
+    {
+        input[ch] = channels[ch].inputBuffer.data() + inputPos - fftSize;
+        output[ch] = channels[ch].fftData.data();
+    }
+
+    (this->*frameKernel)(input.data(), parameters);
+
+    overlapAdd(output.data(), synthesisWindow.data(), numActiveChannels);
+    compactInput();
 }
 
-void SpectralProcessor::process(juce::AudioBuffer<float>& buffer)
+void SpectralProcessor::overlapAdd(const float* const* frames, const float* window, int numChannels)
 {
-    const int numSamples = buffer.getNumSamples();
-    const int numChannels = buffer.getNumChannels();
+    compactOutput();
 
-    for (int sample = 0; sample < numSamples; ++sample)
+    for (int ch = 0; ch < numChannels; ++ch)
     {
-        // Sum channels to mono for input
-        float monoIn = 0.0f;
-        for (int ch = 0; ch < numChannels; ++ch)
-        {
-            monoIn += buffer.getSample(ch, sample);
-        }
-        monoIn /= static_cast<float>(numChannels);
+        // Synthesis window, gain correction and overlap-add in one pass,
+        // unless the frame comes already windowed
+        float* destination = channels[ch].outputBuffer.data() + outputPos;
+        if (window != nullptr)
+            juce::FloatVectorOperations::addWithMultiply(destination, frames[ch], window, fftSize);
+        else
+            juce::FloatVectorOperations::add(destination, frames[ch], fftSize);
+    }
+}
 
-        // Push sample into input FIFO
-        inputFifo[fifoPos] = monoIn;
+void SpectralProcessor::compactOutput()
+{
+    // Make room in the output accumulators if a frame would run past their end.
+    // Everything before outputPos has been read and cleared, only the tails of
+    // earlier frames (fftSize - hopSize samples) are still live.
+    if (outputPos + fftSize <= 2 * fftSize)
+        return;
 
-        // Read from output FIFO
-        float monoOut = outputFifo[fifoPos];
-        outputFifo[fifoPos] = 0.0f;  // Clear for next overlap-add
+    const int overlapLength = fftSize - hopSize;
+    for (int ch = 0; ch < numActiveChannels; ++ch)
+    {
+        float* outPtr = channels[ch].outputBuffer.data();
+        juce::FloatVectorOperations::copy(outPtr, outPtr + outputPos, overlapLength);
+        juce::FloatVectorOperations::clear(outPtr + outputPos, overlapLength);
+    }
 
-        // Write to all output channels
-        for (int ch = 0; ch < numChannels; ++ch)
-        {
-            buffer.setSample(ch, sample, monoOut);
-        }
+    outputPos = 0;
+}
 
-        // Advance position
-        fifoPos = (fifoPos + 1) % FFT_SIZE;
-        frameCount++;
+void SpectralProcessor::compactInput()
+{
+    // Once the input history reaches the end, keep the overlap for the next frame
+    if (inputPos < 2 * fftSize)
+        return;
 
-        // Process frame every hopSize samples
-        if (frameCount >= HOP_SIZE)
+    const int overlapLength = fftSize - hopSize;
+    for (int ch = 0; ch < numActiveChannels; ++ch)
+    {
+        float* inPtr = channels[ch].inputBuffer.data();
+        juce::FloatVectorOperations::copy(inPtr, inPtr + inputPos - overlapLength, overlapLength);
+    }
+
+    inputPos = overlapLength;
+}
+
+float* SpectralProcessor::getSlotFrames(int slot)
+{
+    return pipelineFrames.data() + static_cast<size_t>(slot) * static_cast<size_t>(fftSize * MAX_CHANNELS);
+}
+
+void SpectralProcessor::queueFrame()
+{
+    const juce::int64 frame = framesQueued.load(std::memory_order_relaxed);
+    const FrameParameters parameters = readFrameParameters();
+
+    // Settled, silent and nothing in flight: no frame needed at all
+    if (parameters.inputQuiet && frame == framesCollected && settled.load(std::memory_order_relaxed))
+    {
+        compactOutput();
+        compactInput();
+        return;
+    }
+
+    const int slot = getPipelineSlot(frame);
+    float* frames = getSlotFrames(slot);
+
+    for (int ch = 0; ch < numActiveChannels; ++ch)
+        juce::FloatVectorOperations::copy(frames + ch * fftSize, channels[ch].inputBuffer.data() + inputPos - fftSize,
+                                          fftSize);
+
+    pipelineParameters[static_cast<size_t>(slot)] = parameters;
+    pipelineParameters[static_cast<size_t>(slot)].deadline = blockStartTicks + deadlineTicks;
+    compactInput();
+
+    // Whoever runs the frame sees the slot filled in. Onto an empty queue,
+    // the pool needs to hear about the new deadline too.
+    framesQueued.store(frame + 1);
+
+    if (poolEntry != nullptr && framesRun.load() == frame)
+        poolEntry->deadline.store(pipelineParameters[static_cast<size_t>(slot)].deadline);
+}
+
+void SpectralProcessor::collectFrame()
+{
+    const juce::int64 frame = framesCollected++;
+
+    // Not run yet: the worker is behind or was never scheduled. Run the
+    // backlog here rather than wait on it; at worst this waits out the one
+    // frame the worker is in the middle of.
+    while (framesRun.load(std::memory_order_acquire) <= frame)
+        runNextFrame();
+
+    const int slot = getPipelineSlot(frame);
+    const float* frames = getSlotFrames(slot);
+    const auto& parameters = pipelineParameters[static_cast<size_t>(slot)];
+    jassert(parameters.numChannels == numActiveChannels);
+
+    if (parameters.skipped)
+    {
+        compactOutput();
+        return;
+    }
+
+    std::array<const float*, MAX_CHANNELS> output {};
+    for (int ch = 0; ch < numActiveChannels; ++ch)
+        output[ch] = frames + ch * fftSize;
+
+    overlapAdd(output.data(), nullptr, numActiveChannels);
+}
+
+bool SpectralProcessor::runNextFrame()
+{
+    const ScopedSpinLock lock(frameLock);
+
+    const juce::int64 frame = framesRun.load(std::memory_order_relaxed);
+    if (frame == framesQueued.load(std::memory_order_acquire))
+    {
+        publishDeadline();
+        return false;
+    }
+
+    const int slot = getPipelineSlot(frame);
+    auto& parameters = pipelineParameters[static_cast<size_t>(slot)];
+    float* frames = getSlotFrames(slot);
+
+    // Queued before the audio thread could see the processor settle
+    parameters.skipped = parameters.inputQuiet && settled.load(std::memory_order_relaxed);
+    if (parameters.skipped)
+    {
+        framesRun.store(frame + 1);
+        publishDeadline();
+        return true;
+    }
+
+    std::array<const float*, MAX_CHANNELS> input {};
+    for (int ch = 0; ch < parameters.numChannels; ++ch)
+        input[ch] = frames + ch * fftSize;
+
+    (this->*frameKernel)(input.data(), parameters);
+
+    // Windowed back into the slot, so collecting is a plain add
+    for (int ch = 0; ch < parameters.numChannels; ++ch)
+        juce::FloatVectorOperations::multiply(frames + ch * fftSize, channels[ch].fftData.data(),
+                                              synthesisWindow.data(), fftSize);
+
+    framesRun.store(frame + 1);
+    publishDeadline();
+    return true;
+}
+
+void SpectralProcessor::runQueuedFrames()
+{
+    while (runNextFrame())
+    {
+    }
+}
+
+void SpectralProcessor::publishDeadline()
+{
+    if (poolEntry == nullptr)
+        return;
+
+    // The oldest frame's deadline, or idle. queueFrame() only publishes onto
+    // an empty queue, so a frame queued after the check is caught by the
+    // second one; otherwise it saw the queue empty and publishes itself.
+    const juce::int64 next = framesRun.load();
+    if (next < framesQueued.load())
+    {
+        poolEntry->deadline.store(pipelineParameters[static_cast<size_t>(getPipelineSlot(next))].deadline);
+        return;
+    }
+
+    poolEntry->deadline.store(FramePool::noDeadline);
+
+    if (next < framesQueued.load())
+        poolEntry->deadline.store(pipelineParameters[static_cast<size_t>(getPipelineSlot(next))].deadline);
+}
+
+void SpectralProcessor::discardQueuedFrames()
+{
+    // Waits out a frame in progress; nothing queued survives
+    const ScopedSpinLock lock(frameLock);
+    framesQueued.store(0);
+    framesRun.store(0);
+    framesCollected = 0;
+
+    if (poolEntry != nullptr)
+        poolEntry->deadline.store(FramePool::noDeadline);
+}
+
+void SpectralProcessor::publishSpectrum()
+{
+    // Release makes the slot contents visible to the reader that acquires it;
+    // the slot handed back is one the reader has finished with
+    const int previous = middleSnapshot.exchange(writeSnapshot | snapshotNewFrame, std::memory_order_acq_rel);
+    writeSnapshot = previous & snapshotIndexMask;
+}
+
+const SpectralProcessor::SpectrumSnapshot& SpectralProcessor::readSpectrum()
+{
+    if ((middleSnapshot.load(std::memory_order_relaxed) & snapshotNewFrame) != 0)
+        readSnapshot = middleSnapshot.exchange(readSnapshot, std::memory_order_acq_rel) & snapshotIndexMask;
+
+    return spectrumSnapshots[readSnapshot];
+}
+
+//==============================================================================
+SpectralProcessor::FrozenSpectrum SpectralProcessor::getFrozenSpectrum() const
+{
+    FrozenSpectrum spectrum;
+
+    // A frame writes for a few microseconds a hop, so a retry or two finds a gap
+    for (int attempt = 0; attempt < 16; ++attempt)
+    {
+        const auto sequence = frozenSequence.load(std::memory_order_acquire);
+        if ((sequence & 1) != 0)
         {
-            frameCount = 0;
-            processFrame();
+            std::this_thread::yield();
+            continue;
         }
+
+        const int bins = juce::jlimit(0, MAX_BINS, numBins);
+        spectrum.sampleRate = sampleRate;
+        spectrum.fftSize = fftSize;
+        spectrum.numBins = bins;
+        spectrum.magnitude.resize(static_cast<size_t>(MAX_CHANNELS * bins));
+
+        for (int ch = 0; ch < MAX_CHANNELS; ++ch)
+            std::memcpy(spectrum.magnitude.data() + ch * bins, channels[ch].frozenMagnitude.data(),
+                        sizeof(float) * static_cast<size_t>(bins));
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (frozenSequence.load(std::memory_order_relaxed) != sequence)
+            continue;
+
+        if (juce::FloatVectorOperations::findMaximum(spectrum.magnitude.data(), MAX_CHANNELS * bins) <= 0.0f)
+            break;
+
+        juce::FloatVectorOperations::multiply(spectrum.magnitude.data(), 1.0f / static_cast<float>(spectrum.fftSize),
+                                              MAX_CHANNELS * bins);
+        return spectrum;
     }
+
+    return {};
 }
 
-void SpectralProcessor::getMagnitudeSpectrum(float* magnitudes, int numBins) const
+void SpectralProcessor::setFrozenSpectrum(const FrozenSpectrum& spectrum)
 {
-    int count = juce::jmin(numBins, NUM_BINS);
-    for (int i = 0; i < count; ++i)
+    // Waits out a frame that is taking the previous one
+    int state = frozenQueueState.load(std::memory_order_relaxed);
+    for (;;)
     {
-        magnitudes[i] = visualMagnitude[i].load();
+        if (state == frozenWriting || state == frozenTaking)
+        {
+            std::this_thread::yield();
+            state = frozenQueueState.load(std::memory_order_relaxed);
+        }
+        else if (frozenQueueState.compare_exchange_weak(state, frozenWriting, std::memory_order_acquire))
+        {
+            break;
+        }
     }
+
+    const bool valid = spectrum.numBins > 0 && spectrum.numBins <= MAX_BINS && spectrum.fftSize > 0
+                       && spectrum.sampleRate > 0.0
+                       && spectrum.magnitude.size() >= static_cast<size_t>(MAX_CHANNELS * spectrum.numBins);
+
+    queuedFrozenBins = valid ? spectrum.numBins : 0;
+    queuedFrozenSize = spectrum.fftSize;
+    queuedFrozenRate = spectrum.sampleRate;
+
+    if (valid)
+        for (int ch = 0; ch < MAX_CHANNELS; ++ch)
+            std::memcpy(queuedFrozen[ch].data(), spectrum.magnitude.data() + ch * spectrum.numBins,
+                        sizeof(float) * static_cast<size_t>(spectrum.numBins));
+
+    frozenQueueState.store(frozenQueued, std::memory_order_release);
+
+    // A settled processor skips silent frames, and with them the hand-over
+    settled.store(false);
 }
 
-void SpectralProcessor::getFrozenSpectrum(float* magnitudes, int numBins) const
+void SpectralProcessor::takeQueuedFrozenSpectrum()
 {
-    int count = juce::jmin(numBins, NUM_BINS);
-    for (int i = 0; i < count; ++i)
+    int expected = frozenQueued;
+    if (!frozenQueueState.compare_exchange_strong(expected, frozenTaking, std::memory_order_acquire))
+        return;
+
+    // Bin j of this frame lies at bin j * ratio of the saved one
+    const int sourceBins = queuedFrozenBins;
+    const double ratio = sourceBins > 0 ? (sampleRate / fftSize) * (queuedFrozenSize / queuedFrozenRate) : 0.0;
+    const float scale = static_cast<float>(fftSize);
+
+    for (int ch = 0; ch < MAX_CHANNELS; ++ch)
     {
-        magnitudes[i] = visualFrozen[i].load();
+        const float* source = queuedFrozen[ch].data();
+        float* frozen = channels[ch].frozenMagnitude.data();
+
+        for (int j = 0; j < numBins; ++j)
+        {
+            const double position = j * ratio;
+            const int index = static_cast<int>(position);
+            float value = 0.0f;
+
+            if (index + 1 < sourceBins)
+                value = source[index] + (source[index + 1] - source[index]) * static_cast<float>(position - index);
+            else if (index < sourceBins)
+                value = source[index];
+
+            frozen[j] = value * scale;
+        }
     }
+
+    frozenQueueState.store(frozenIdle, std::memory_order_release);
 }
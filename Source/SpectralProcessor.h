@@ -9,24 +9,71 @@
 #pragma once
 
 #include <juce_dsp/juce_dsp.h>
+#include "FramePool.h"
 #include <array>
 #include <atomic>
+#include <memory>
+#include <vector>
 
-class SpectralProcessor
+class ModulationEngine;
+
+// Cache-line aligned, so processors running on different cores never share a line
+class alignas(64) SpectralProcessor
 {
 public:
-    static constexpr int FFT_ORDER = 10;  // 1024 samples - lower latency
-    static constexpr int FFT_SIZE = 1 << FFT_ORDER;
-    static constexpr int NUM_BINS = FFT_SIZE / 2 + 1;
-    static constexpr int OVERLAP = 4;  // 75% overlap
-    static constexpr int HOP_SIZE = FFT_SIZE / OVERLAP;
+    // Supported frame sizes: 256 to 8192 points
+    static constexpr int MIN_FFT_ORDER = 8;
+    static constexpr int MAX_FFT_ORDER = 13;
+    static constexpr int NUM_FFT_SIZES = MAX_FFT_ORDER - MIN_FFT_ORDER + 1;
+    static constexpr int MAX_FFT_SIZE = 1 << MAX_FFT_ORDER;
+    static constexpr int MAX_BINS = MAX_FFT_SIZE / 2 + 1;
+    static constexpr int BIN_STRIDE = (MAX_BINS + 15) / 16 * 16;   // MAX_BINS padded to whole 64-byte lines
+
+    static constexpr int DEFAULT_FFT_ORDER = 10;  // 1024 samples - lower latency
+    static constexpr int DEFAULT_OVERLAP = 4;     // 75% overlap
+    static constexpr int MAX_CHANNELS = 2;
 
     SpectralProcessor();
+    ~SpectralProcessor();
 
     void prepare(double sampleRate, int maxBlockSize);
     void process(juce::AudioBuffer<float>& buffer);
     void reset();
 
+    // Frame size (log2, MIN_FFT_ORDER..MAX_FFT_ORDER) and overlap (2, 4 or 8).
+    // Switching clears the STFT state but never allocates, so it can be
+    // called from the audio thread between process() calls.
+    void setFrameSize(int newFftOrder, int newOverlap);
+
+    // Pipelined mode hands frames to the process-wide FramePool, so process()
+    // only copies samples in and finished frames out. A frame is collected
+    // the prepared block size, rounded up to whole hops, after it was queued,
+    // which adds that much latency. Like setFrameSize(), safe to call from the
+    // audio thread between process() calls.
+    void setPipelined(bool shouldPipeline);
+    bool isPipelined() const { return pipelined; }
+
+    // Only members of the pool get their frames run on it; until then, or if
+    // the pool is full, pipelined frames run on the audio thread when they
+    // fall due. The first call with shouldBeMember joins, creating the pool
+    // if no other processor has; later calls without it leave once pipelined
+    // mode is off, so the pool's threads go with its last member. Not for the
+    // audio thread: call it from a timer or before processing starts.
+    void updatePoolMembership(bool shouldBeMember);
+
+    // FFT order that keeps roughly the same time/frequency trade-off as
+    // 1024 points at 48 kHz for the given sample rate
+    static int getAutoFFTOrder(double sampleRate);
+
+    int getFFTOrder() const { return fftOrder; }
+    int getFFTSize() const { return fftSize; }
+    int getOverlap() const { return overlap; }
+    int getHopSize() const { return hopSize; }
+    int getNumBins() const { return numBins; }
+
+    // Delay between input and output in samples
+    int getLatencySamples() const { return fftSize + pipelineDepth * hopSize; }
+
     // Control parameters
     void setFreezeAmount(float amount) { freezeAmount.store(amount); }
     void setSmearAmount(float amount) { smearAmount.store(amount); }
@@ -35,44 +82,236 @@ public:
     void setTiltAmount(float amount) { tiltAmount.store(amount); }        // -1 to +1
     void setFeedbackAmount(float amount) { feedbackAmount.store(amount); } // 0 to 1
 
+    // Linked stereo: one magnitude analysis drives both channels, keeping
+    // their phase and level differences. Unlinked runs each channel on its own.
+    void setStereoLinked(bool linked) { stereoLinked.store(linked); }
+
+    // Scatter's phase noise is a function of the seed and the frame count
+    // since reset, so renders with the same seed come out identical
+    void setRandomSeed(juce::uint32 seed) { randomSeed.store(seed); }
+
+    // Optional LFO modulation of the amounts above, advanced once per hop.
+    // Set before processing starts; the engine is only used on the audio thread.
+    void setModulation(ModulationEngine* engine) { modulation = engine; }
+
     // Interaction zones (normalized 0-1)
     void setInteractionY(float y) { interactionY.store(y); }
     void setInteractionRadius(float r) { interactionRadius.store(r); }
     void setInteractionActive(bool active) { interactionActive.store(active); }
 
-    // Get magnitude spectrum for visualization
-    void getMagnitudeSpectrum(float* magnitudes, int numBins) const;
-    void getFrozenSpectrum(float* magnitudes, int numBins) const;
+    // Spectrum for visualization, published once per frame. Raw magnitudes
+    // summed over the processed spectra; display mapping is up to the reader.
+    struct SpectrumSnapshot
+    {
+        std::array<float, MAX_BINS> magnitude {};
+        std::array<float, MAX_BINS> frozen {};
+        int numBins = 0;
+        double sampleRate = 44100.0;
+        float scale = 1.0f;         // Multiply by this for amplitude relative to full scale
+        juce::uint64 sequence = 0;  // Frame number, 0 = nothing published yet
+    };
+
+    // Newest complete frame. Single reader (the message thread): the returned
+    // snapshot stays untouched until the next call.
+    const SpectrumSnapshot& readSpectrum();
+
+    // What freeze is holding, for saving with the plugin state. Magnitudes
+    // are divided by the frame size, so they carry over to other frame
+    // sizes and rates; numBins = 0 when nothing is frozen.
+    struct FrozenSpectrum
+    {
+        double sampleRate = 0.0;
+        int fftSize = 0;
+        int numBins = 0;
+        std::vector<float> magnitude;   // MAX_CHANNELS runs of numBins
+    };
+
+    // Not for the audio thread; never waits for it
+    FrozenSpectrum getFrozenSpectrum() const;
+
+    // Queues a frozen spectrum for the next frame to take up, resampled to
+    // the frame size and rate in use then. numBins = 0 clears what freeze
+    // holds. Not for the audio thread.
+    void setFrozenSpectrum(const FrozenSpectrum& spectrum);
+
+    // Total STFT frames processed since construction (for profiling, from any thread)
+    juce::int64 getNumFramesProcessed() const { return framesProcessed.load(std::memory_order_relaxed); }
 
 private:
+    // Everything a frame needs from the audio thread, read when its hop
+    // completes: the parameter values after modulation and the channel layout
+    struct FrameParameters
+    {
+        float freeze = 0.0f;
+        float smear = 0.0f;
+        float scatter = 0.0f;
+        float shift = 0.0f;
+        float tilt = 0.0f;
+        float feedback = 0.0f;
+        int numChannels = 1;
+        bool linked = false;
+        juce::uint32 seed = 0;
+        juce::uint32 frameIndex = 0;  // Frames since reset, keys the scatter noise
+        bool inputQuiet = false;    // The whole analysis window is silent
+        juce::int64 deadline = 0;   // Pipelined: when it must be done, in high-resolution ticks
+        bool skipped = false;       // Pipelined, set when run: came out silent without being computed
+    };
+
+    FrameParameters readFrameParameters();
+
+    // Window, forward FFT, effects and inverse FFT of one frame per channel,
+    // leaving the unwindowed result in each channel's fftData. One
+    // instantiation per frame size, picked from a table on setFrameSize().
+    template <int Order> void transformFrame(const float* const* input, const FrameParameters& parameters);
+    using FrameKernel = void (SpectralProcessor::*)(const float* const*, const FrameParameters&);
+    static const std::array<FrameKernel, NUM_FFT_SIZES> frameKernels;
+
+    void processChannels(float* const* channelData, int numSamples);
+
+    // Hop boundary work: the whole frame on the spot, or in pipelined mode
+    // the oldest frame collected and the new one queued
     void processFrame();
-    void processSpectrum();
-
-    juce::dsp::FFT fft { FFT_ORDER };
-    juce::dsp::WindowingFunction<float> window { FFT_SIZE + 1,
-        juce::dsp::WindowingFunction<float>::hann, false };
-
-    // Gain correction for Hann window with 75% overlap
-    // Squared Hann has avg value 3/8, times 4 overlaps = 1.5, so multiply by 2/3
-    static constexpr float windowCorrection = 2.0f / 3.0f;
-
-    // FIFO buffers
-    std::array<float, FFT_SIZE> inputFifo;
-    std::array<float, FFT_SIZE> outputFifo;
-    int fifoPos = 0;
-    int frameCount = 0;
-
-    // FFT working data
-    std::array<float, FFT_SIZE * 2> fftData;
-
-    // Spectral data
-    std::array<float, NUM_BINS> magnitude;
-    std::array<float, NUM_BINS> phase;
-    std::array<float, NUM_BINS> frozenMagnitude;
-    std::array<float, NUM_BINS> frozenPhase;
-    std::array<float, NUM_BINS> smearBuffer;
-    std::array<float, NUM_BINS> feedbackBuffer;
-    std::array<float, NUM_BINS> shiftedMagnitude;
+    void queueFrame();
+    void collectFrame();
+    void overlapAdd(const float* const* frames, const float* window, int numChannels);
+    void compactOutput();
+    void compactInput();
+
+    // Silence detection. The audio thread counts silent input per hop; the
+    // frame runner settles once a silent frame leaves nothing audible in the
+    // effect state, and from then on skips silent frames without an FFT.
+    void trackInputLevel();
+    void updateSettled(bool inputQuiet, int numSpectra);
+
+    // Slot of a frame number, and its samples: one fftSize run per channel
+    int getPipelineSlot(juce::int64 frame) const { return static_cast<int>(frame % pipelineDepth); }
+    float* getSlotFrames(int slot);
+
+    // Pipeline: runs the oldest queued frame if there is one, on whichever
+    // thread gets the frame lock. The pool drains a processor through
+    // runQueuedFrames() and learns of its oldest frame through publishDeadline().
+    friend class FramePool;
+    bool runNextFrame();
+    void runQueuedFrames();
+    void publishDeadline();
+    void discardQueuedFrames();
+    void configurePipeline();
+
+    // Audio thread: picks up the entry updatePoolMembership() registered, or
+    // hands it back when pipelined mode goes off
+    void takePoolEntry();
+    void releasePoolEntry();
+
+    void processSpectrum(const FrameParameters& parameters);
+    void publishSpectrum();
+
+    // Frozen state hand-over. Whoever writes the frozen magnitudes or the
+    // frame configuration holds a FrozenWriteScope, which keeps the sequence
+    // odd meanwhile; readers copy and retry if it moved.
+    struct FrozenWriteScope;
+    void takeQueuedFrozenSpectrum();
+
+    // Coefficient caches, rebuilt only when their parameter or the frame size changes
+    void updateShiftMap(float shift);
+    void updateTiltGains(float tilt);
+
+    std::array<std::unique_ptr<juce::dsp::FFT>, NUM_FFT_SIZES> ffts;
+
+    // Active frame configuration
+    int fftOrder = DEFAULT_FFT_ORDER;
+    int fftSize = 1 << DEFAULT_FFT_ORDER;
+    int numBins = (1 << DEFAULT_FFT_ORDER) / 2 + 1;
+    int overlap = DEFAULT_OVERLAP;
+    int hopSize = (1 << DEFAULT_FFT_ORDER) / DEFAULT_OVERLAP;
+    FrameKernel frameKernel = nullptr;
+
+    // Effect time constants are tuned for a 256-sample hop; this rescales
+    // them so other frame sizes decay over the same time
+    float hopTimeScale = 1.0f;
+
+    // Analysis window (fftSize + 1 points, first fftSize used) and the
+    // synthesis window pre-multiplied by the overlap-add gain correction.
+    // Hann for 4x/8x; sqrt-Hann for 2x, where Hann^2 doesn't overlap-add flat.
+    std::array<float, MAX_FFT_SIZE + 1> analysisWindow;
+    std::array<float, MAX_FFT_SIZE> synthesisWindow;
+
+    // Per-channel STFT state.
+    // The input and output are linear double-length buffers: the input holds
+    // the analysis history so a frame is always one contiguous fftSize run,
+    // the output accumulates overlap-add contributions ahead of the read
+    // position. Both are compacted once they run out of room instead of
+    // wrapping per sample.
+    // fftData stays interleaved (re, im), the layout juce::dsp::FFT works in;
+    // the kernels split it in registers. The per-bin state is one run per
+    // field, each starting on its own cache line.
+    struct ChannelState
+    {
+        alignas(64) std::array<float, MAX_FFT_SIZE * 2> inputBuffer;
+        alignas(64) std::array<float, MAX_FFT_SIZE * 2> outputBuffer;
+        alignas(64) std::array<float, MAX_FFT_SIZE * 2> fftData;
+
+        alignas(64) std::array<float, BIN_STRIDE> magnitude;        // As analysed
+        alignas(64) std::array<float, BIN_STRIDE> phase;            // Only analysed when scatter needs it
+        alignas(64) std::array<float, BIN_STRIDE> outputMagnitude;  // After all effects
+        alignas(64) std::array<float, BIN_STRIDE> frozenMagnitude;
+        alignas(64) std::array<float, BIN_STRIDE> smearBuffer;
+        alignas(64) std::array<float, BIN_STRIDE> feedbackBuffer;
+
+        void reset();
+    };
+
+    void analyse(ChannelState& state, bool needsPhase);
+    void analyseLinked();
+    void applyEffects(ChannelState& state, const float* inputMagnitude, float freeze, float smear,
+                      float scatter, float shift, float tilt, float feedback);
+    void resynthesise(ChannelState& state, bool applyPhaseNoise);
+    void resynthesiseLinked(bool applyPhaseNoise);
+
+    std::array<ChannelState, MAX_CHANNELS> channels;
+    int numActiveChannels = 1;   // Audio thread, for the sample I/O
+    int frameChannels = 1;       // The frame being transformed
+
+    // Positions are shared by all channels
+    int inputPos = 0;          // Write position, frame = [inputPos - fftSize, inputPos)
+    int outputPos = 0;         // Read position
+    int hopPos = 0;            // Samples collected in the current hop
+    int quietSamples = 0;      // Silent input samples in a row, up to fftSize
+    std::atomic<bool> settled { false };   // Silent frames would come out silent: skip them
+    std::atomic<juce::int64> framesProcessed { 0 };   // Bumped by whichever thread ran the frame
+
+    // Per-frame values shared by every channel
+    alignas(64) std::array<float, BIN_STRIDE> shiftedMagnitude;
+    alignas(64) std::array<float, BIN_STRIDE> shapedMagnitude;  // Input magnitude after shift/tilt
+    alignas(64) std::array<float, BIN_STRIDE> tiltGain;
+    float tiltGainAmount = 0.0f;
+    int tiltGainBins = 0;                         // 0 = needs rebuilding
+
+    // Shift map: source bin i lands between shiftTarget[i] and the bin above,
+    // the upper one taking shiftFraction[i]. Only [shiftBegin, shiftEnd) land
+    // inside the spectrum.
+    std::array<int, MAX_BINS> shiftTarget;
+    std::array<float, MAX_BINS> shiftFraction;
+    int shiftBegin = 0;
+    int shiftEnd = 0;
+    float shiftMapAmount = 0.0f;
+    int shiftMapBins = 0;                         // 0 = needs rebuilding
+
+    alignas(64) std::array<float, BIN_STRIDE> phaseNoise;
+    alignas(64) std::array<float, BIN_STRIDE> noiseSin;         // Linked mode phase noise rotation
+    alignas(64) std::array<float, BIN_STRIDE> noiseCos;
+    alignas(64) std::array<float, BIN_STRIDE> linkedMagnitude;  // Linked mode analysis before effects
+
+    // Frozen state coming in from a saved session, written by the message
+    // thread and taken by the next frame
+    enum { frozenIdle, frozenWriting, frozenQueued, frozenTaking };
+    std::atomic<int> frozenQueueState { frozenIdle };
+    std::array<std::array<float, BIN_STRIDE>, MAX_CHANNELS> queuedFrozen;
+    double queuedFrozenRate = 0.0;
+    int queuedFrozenSize = 0;
+    int queuedFrozenBins = 0;
+
+    std::atomic<juce::uint32> frozenSequence { 0 };
+    int frozenWriteDepth = 0;            // Held by the audio thread or the frame runner, never both
 
     // Parameters
     std::atomic<float> freezeAmount { 0.0f };
@@ -84,12 +323,50 @@ private:
     std::atomic<float> interactionY { 0.5f };
     std::atomic<float> interactionRadius { 0.2f };
     std::atomic<bool> interactionActive { false };
+    std::atomic<bool> stereoLinked { false };
+    std::atomic<juce::uint32> randomSeed { 0 };
+    juce::uint32 frameIndex = 0;   // Audio thread, counted as frames are read out
+
+    ModulationEngine* modulation = nullptr;
 
     double sampleRate = 44100.0;
 
-    // Visualization (atomic for thread safety)
-    mutable std::array<std::atomic<float>, NUM_BINS> visualMagnitude;
-    mutable std::array<std::atomic<float>, NUM_BINS> visualFrozen;
+    // Visualization triple buffer. The audio thread fills the write slot and
+    // swaps it into the middle; the reader swaps the middle out when the
+    // new-frame flag is set. Neither side ever waits for the other.
+    static constexpr int snapshotIndexMask = 3;
+    static constexpr int snapshotNewFrame = 4;
+
+    std::array<SpectrumSnapshot, 3> spectrumSnapshots;
+    std::atomic<int> middleSnapshot { 1 };
+    int writeSnapshot = 0;   // Audio thread only
+    int readSnapshot = 2;    // Reader only
+    juce::uint64 spectrumSequence = 0;
+
+    // Pipelined mode. Frames go through a ring of pipelineDepth slots, each
+    // holding one fftSize run per channel: the input as queued, then the
+    // windowed output. The counters only ever grow between resets; the audio
+    // thread queues and collects, and frames are run in order under the lock.
+    bool pipelined = false;
+    int pipelineDepth = 0;                           // Hops between queueing and collecting, 0 = off
+    int preparedBlockSize = 0;
+    std::vector<float> pipelineFrames;
+    std::vector<FrameParameters> pipelineParameters;
+    juce::SpinLock frameLock;                        // Spun on, never yielded on (ScopedSpinLock)
+
+    // The audio thread's counters and the frame runner's each get a line of
+    // their own, so neither side's writes evict what the other is reading
+    alignas(64) std::atomic<juce::int64> framesQueued { 0 };
+    juce::int64 framesCollected = 0;                 // Audio thread only
+    juce::int64 blockStartTicks = 0;                 // Audio thread, when the current block started
+    juce::int64 deadlineTicks = 0;                   // Pipeline depth in high-resolution ticks
+    alignas(64) std::atomic<juce::int64> framesRun { 0 };
 
-    juce::Random random;
+    // Pool membership. pool and registeredEntry belong to the thread calling
+    // updatePoolMembership(), poolEntry to the audio thread (read by the frame
+    // runner under frameLock); idleEntry passes the entry between them.
+    alignas(64) std::shared_ptr<FramePool> pool;
+    FramePool::Entry* registeredEntry = nullptr;
+    std::atomic<FramePool::Entry*> idleEntry { nullptr };
+    FramePool::Entry* poolEntry = nullptr;
 };
@@ -0,0 +1,120 @@
+/*
+  ==============================================================================
+    RIPPLE - Spectrum Display Implementation
+  ==============================================================================
+*/
+
+#include "SpectrumDisplay.h"
+#include <cmath>
+
+namespace
+{
+    double hzToMel(double hz) { return 2595.0 * std::log10(1.0 + hz / 700.0); }
+    double melToHz(double mel) { return 700.0 * (std::pow(10.0, mel / 2595.0) - 1.0); }
+}
+
+float SpectrumDisplay::toDisplay(float amplitude)
+{
+    return juce::jlimit(0.0f, 1.0f, std::pow(amplitude, 0.35f) * 10.0f);
+}
+
+void SpectrumDisplay::rebuildBands(int numBins, double sampleRate)
+{
+    tableNumBins = numBins;
+    tableSampleRate = sampleRate;
+
+    // Bin k covers [k - 0.5, k + 0.5) bin widths, clipped to [0, Nyquist]
+    const double nyquist = sampleRate * 0.5;
+    const double binWidth = nyquist / (numBins - 1);
+    const double minMel = hzToMel(juce::jmin(static_cast<double>(MIN_FREQUENCY), nyquist * 0.5));
+    const double maxMel = hzToMel(nyquist);
+
+    int weightOffset = 0;
+    double low = melToHz(minMel);
+
+    for (int i = 0; i < NUM_BANDS; ++i)
+    {
+        const double high = i == NUM_BANDS - 1 ? nyquist
+                                               : melToHz(minMel + (maxMel - minMel) * (i + 1) / NUM_BANDS);
+
+        const int first = juce::jlimit(0, numBins - 1, static_cast<int>(std::floor(low / binWidth + 0.5)));
+        const int last = juce::jlimit(first, numBins - 1, static_cast<int>(std::floor(high / binWidth + 0.5)));
+
+        auto& band = bandTable[i];
+        band.firstBin = first;
+        band.numBins = last - first + 1;
+        band.weightOffset = weightOffset;
+
+        double total = 0.0;
+        for (int k = first; k <= last; ++k)
+        {
+            const double overlap = juce::jmin(high, (k + 0.5) * binWidth) - juce::jmax(low, (k - 0.5) * binWidth);
+            bandWeights[weightOffset + k - first] = static_cast<float>(juce::jmax(0.0, overlap));
+            total += juce::jmax(0.0, overlap);
+        }
+
+        // Normalise; a degenerate band just repeats its nearest bin
+        for (int k = 0; k < band.numBins; ++k)
+            bandWeights[weightOffset + k] = total > 0.0 ? static_cast<float>(bandWeights[weightOffset + k] / total)
+                                                        : (k == 0 ? 1.0f : 0.0f);
+
+        weightOffset += band.numBins;
+        low = high;
+    }
+}
+
+void SpectrumDisplay::applyBands(const float* bins, float scale, float* out) const
+{
+    for (int i = 0; i < NUM_BANDS; ++i)
+    {
+        const auto& band = bandTable[i];
+        const float* source = bins + band.firstBin;
+        const float* weights = bandWeights.data() + band.weightOffset;
+
+        float sum = 0.0f;
+        for (int k = 0; k < band.numBins; ++k)
+            sum += source[k] * weights[k];
+        out[i] = sum * scale;
+    }
+}
+
+bool SpectrumDisplay::update(const SpectralProcessor::SpectrumSnapshot& snapshot)
+{
+    if (snapshot.sequence == 0 || snapshot.sequence == lastSequence || snapshot.numBins < 2)
+        return false;
+
+    lastSequence = snapshot.sequence;
+
+    if (snapshot.numBins != tableNumBins || snapshot.sampleRate != tableSampleRate)
+        rebuildBands(snapshot.numBins, snapshot.sampleRate);
+
+    // === SPECTRUM with ballistics and peak hold ===
+    applyBands(snapshot.magnitude.data(), snapshot.scale, bands.data());
+    for (int i = 0; i < NUM_BANDS; ++i)
+    {
+        const float target = toDisplay(bands[i]);
+        const float coeff = target > spectrum[i] ? attack : 1.0f - release;
+        spectrum[i] += (target - spectrum[i]) * coeff;
+
+        if (spectrum[i] >= peaks[i])
+        {
+            peaks[i] = spectrum[i];
+            peakHold[i] = peakHoldFrames;
+        }
+        else if (peakHold[i] > 0)
+        {
+            --peakHold[i];
+        }
+        else
+        {
+            peaks[i] *= peakFall;
+        }
+    }
+
+    // === FROZEN (already smoothed by the freeze capture) ===
+    applyBands(snapshot.frozen.data(), snapshot.scale, bands.data());
+    for (int i = 0; i < NUM_BANDS; ++i)
+        frozen[i] = toDisplay(bands[i]);
+
+    return true;
+}
@@ -0,0 +1,67 @@
+/*
+  ==============================================================================
+    RIPPLE - Spectrum Display
+    Turns the raw spectrum frames published by SpectralProcessor into the
+    values the web UI draws: banding, normalisation, perceptual curve and
+    meter ballistics. Runs on the message thread only.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "SpectralProcessor.h"
+
+class SpectrumDisplay
+{
+public:
+    // Mel-spaced bands from MIN_FREQUENCY up to Nyquist
+    static constexpr int NUM_BANDS = 128;
+    static constexpr float MIN_FREQUENCY = 20.0f;
+
+    // Maps a new frame. Returns false (and leaves the display alone) if the
+    // frame was already seen, e.g. while the host isn't processing.
+    bool update(const SpectralProcessor::SpectrumSnapshot& snapshot);
+
+    // Display values, 0..1 per band
+    const std::array<float, NUM_BANDS>& getSpectrum() const { return spectrum; }
+    const std::array<float, NUM_BANDS>& getFrozen() const { return frozen; }
+    const std::array<float, NUM_BANDS>& getPeaks() const { return peaks; }
+
+private:
+    // Perceptual curve: amplitude relative to full scale -> 0..1
+    static float toDisplay(float amplitude);
+
+    // Banding table: band i is the weighted sum of numBins FFT bins from
+    // firstBin, weights normalised to 1. Bins only partly inside a band
+    // (and low bands narrower than one bin) get fractional weights.
+    // Rebuilt only when the bin count or sample rate changes.
+    void rebuildBands(int numBins, double sampleRate);
+    void applyBands(const float* bins, float scale, float* out) const;
+
+    struct Band
+    {
+        int firstBin = 0;
+        int numBins = 0;
+        int weightOffset = 0;
+    };
+
+    std::array<Band, NUM_BANDS> bandTable {};
+    std::array<float, SpectralProcessor::MAX_BINS + NUM_BANDS * 2> bandWeights {};
+    int tableNumBins = 0;
+    double tableSampleRate = 0.0;
+
+    // Ballistics per displayed frame (one per editor tick): fast attack,
+    // slower release, and peaks that hold for a while before falling
+    static constexpr float attack = 0.7f;
+    static constexpr float release = 0.75f;
+    static constexpr int peakHoldFrames = 15;
+    static constexpr float peakFall = 0.92f;
+
+    std::array<float, NUM_BANDS> bands {};
+    std::array<float, NUM_BANDS> spectrum {};
+    std::array<float, NUM_BANDS> frozen {};
+    std::array<float, NUM_BANDS> peaks {};
+    std::array<int, NUM_BANDS> peakHold {};
+
+    juce::uint64 lastSequence = 0;
+};
@@ -0,0 +1,129 @@
+/*
+  ==============================================================================
+    RIPPLE - WebUI Resources Implementation
+  ==============================================================================
+*/
+
+#include "WebUIResources.h"
+
+#if RIPPLE_EMBEDDED_WEBUI
+#include "WebUIData.h"
+#endif
+
+namespace
+{
+    struct MimeType
+    {
+        const char* extension;
+        const char* type;
+    };
+
+    constexpr MimeType mimeTypes[] = {
+        { "html", "text/html" },
+        { "htm", "text/html" },
+        { "css", "text/css" },
+        { "js", "text/javascript" },
+        { "mjs", "text/javascript" },
+        { "json", "application/json" },
+        { "map", "application/json" },
+        { "wasm", "application/wasm" },
+        { "svg", "image/svg+xml" },
+        { "png", "image/png" },
+        { "jpg", "image/jpeg" },
+        { "jpeg", "image/jpeg" },
+        { "gif", "image/gif" },
+        { "webp", "image/webp" },
+        { "ico", "image/x-icon" },
+        { "woff", "font/woff" },
+        { "woff2", "font/woff2" },
+        { "ttf", "font/ttf" },
+        { "otf", "font/otf" },
+        { "txt", "text/plain" }
+    };
+
+    juce::String pathFromUrl(const juce::String& url)
+    {
+        // Drop the leading slash and any query or fragment
+        auto path = url.upToFirstOccurrenceOf("?", false, false)
+                       .upToFirstOccurrenceOf("#", false, false)
+                       .trimCharactersAtStart("/");
+        return path.isEmpty() ? juce::String("index.html") : path;
+    }
+}
+
+//==============================================================================
+const WebUIResources& WebUIResources::getInstance()
+{
+    // Function-local static: built once, thread-safe, lives until shutdown
+    static const WebUIResources instance;
+    return instance;
+}
+
+WebUIResources::WebUIResources()
+{
+#if RIPPLE_EMBEDDED_WEBUI
+    for (int i = 0; i < WebUIData::namedResourceListSize; ++i)
+    {
+        const char* name = WebUIData::namedResourceList[i];
+        int size = 0;
+        const char* data = WebUIData::getNamedResource(name, size);
+        // Staged by CMake as the path relative to Resources/WebUI, slashes escaped
+        const auto path = juce::String(WebUIData::getNamedResourceOriginalFilename(name)).replace("%2F", "/");
+
+        if (data != nullptr)
+            entries[path] = { reinterpret_cast<const std::byte*>(data), static_cast<size_t>(size), getMimeType(path) };
+    }
+#endif
+
+    if (entries.empty())
+    {
+        auto executableDir = juce::File::getSpecialLocation(juce::File::currentExecutableFile).getParentDirectory();
+
+        resourcesDir = executableDir.getChildFile("Resources").getChildFile("WebUI");
+        if (!resourcesDir.isDirectory())
+            resourcesDir = executableDir.getParentDirectory()
+                               .getChildFile("Resources")
+                               .getChildFile("WebUI");
+    }
+}
+
+const char* WebUIResources::getMimeType(const juce::String& path)
+{
+    const auto extension = path.fromLastOccurrenceOf(".", false, false).toLowerCase();
+
+    for (const auto& mime : mimeTypes)
+        if (extension == mime.extension)
+            return mime.type;
+
+    return "application/octet-stream";
+}
+
+std::optional<juce::WebBrowserComponent::Resource> WebUIResources::getResource(const juce::String& url) const
+{
+    const auto path = pathFromUrl(url);
+
+    if (!entries.empty())
+    {
+        auto it = entries.find(path);
+        if (it == entries.end())
+            return std::nullopt;
+
+        // The provider API takes ownership of a vector, so this is the one copy
+        const auto& entry = it->second;
+        return juce::WebBrowserComponent::Resource { std::vector<std::byte>(entry.data, entry.data + entry.size),
+                                                     entry.mimeType };
+    }
+
+    // Not embedded: read straight from disk into the response
+    auto file = resourcesDir.getChildFile(path);
+    if (!file.existsAsFile() || !file.isAChildOf(resourcesDir))
+        return std::nullopt;
+
+    juce::FileInputStream stream(file);
+    if (!stream.openedOk())
+        return std::nullopt;
+
+    std::vector<std::byte> data(static_cast<size_t>(stream.getTotalLength()));
+    stream.read(data.data(), static_cast<int>(data.size()));
+    return juce::WebBrowserComponent::Resource { std::move(data), getMimeType(path) };
+}
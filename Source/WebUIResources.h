@@ -0,0 +1,44 @@
+/*
+  ==============================================================================
+    RIPPLE - WebUI Resources
+    Serves the web UI bundle to the WebView resource provider.
+    Release builds compile the bundle in (juce_add_binary_data); builds made
+    without a web build fall back to Resources/WebUI next to the binary.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_gui_extra/juce_gui_extra.h>
+#include <map>
+#include <optional>
+
+class WebUIResources
+{
+public:
+    // Shared by every editor in the process, built on first use
+    static const WebUIResources& getInstance();
+
+    // Resource for a provider URL ("/" = index.html), or nullopt if unknown
+    std::optional<juce::WebBrowserComponent::Resource> getResource(const juce::String& url) const;
+
+    static const char* getMimeType(const juce::String& path);
+
+private:
+    WebUIResources();
+
+    struct Entry
+    {
+        const std::byte* data = nullptr;
+        size_t size = 0;
+        const char* mimeType = nullptr;
+    };
+
+    // Embedded files, keyed by path relative to the bundle root, as on disk
+    std::map<juce::String, Entry> entries;
+
+    // Disk fallback when nothing is embedded
+    juce::File resourcesDir;
+
+    JUCE_DECLARE_NON_COPYABLE(WebUIResources)
+};
@@ -0,0 +1,297 @@
+/*
+  ==============================================================================
+    RIPPLE - Realtime Guard Implementation
+    Set RIPPLE_REALTIME_ABORT=1 to abort on the first violation, so a
+    debugger stops on the offending call.
+  ==============================================================================
+*/
+
+#include "RealtimeGuard.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#if defined(__linux__)
+ #include <dlfcn.h>
+ #include <pthread.h>
+ #include <semaphore.h>
+ #include <sched.h>
+ #include <time.h>
+ #include <unistd.h>
+ #include <cerrno>
+#endif
+
+namespace
+{
+    thread_local bool onAudioThread = false;
+
+    std::atomic<int> numViolations { 0 };
+    std::atomic<const char*> firstViolation { nullptr };
+
+    const bool abortOnViolation = std::getenv("RIPPLE_REALTIME_ABORT") != nullptr;
+
+    // Nothing in here may allocate or lock: it runs inside the hooks
+    void check(const char* what)
+    {
+        if (!onAudioThread)
+            return;
+
+        if (numViolations.fetch_add(1) == 0)
+            firstViolation.store(what);
+
+        if (abortOnViolation)
+        {
+            onAudioThread = false;
+            std::fprintf(stderr, "Realtime violation: %s\n", what);
+            std::abort();
+        }
+    }
+}
+
+namespace RealtimeGuard
+{
+    ScopedAudioThread::ScopedAudioThread() { onAudioThread = true; }
+    ScopedAudioThread::~ScopedAudioThread() { onAudioThread = false; }
+
+    int getNumViolations() { return numViolations.load(); }
+    const char* getFirstViolation() { return firstViolation.load(); }
+
+    void clear()
+    {
+        numViolations.store(0);
+        firstViolation.store(nullptr);
+    }
+
+   #if defined(__linux__)
+    bool hooksSystemCalls() { return true; }
+   #else
+    bool hooksSystemCalls() { return false; }
+   #endif
+}
+
+//==============================================================================
+// operator new/delete: every platform
+void* operator new(std::size_t size)
+{
+    check("operator new");
+    if (auto* p = std::malloc(size == 0 ? 1 : size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    check("operator new[]");
+    if (auto* p = std::malloc(size == 0 ? 1 : size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    check("operator new");
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    check("operator new[]");
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void operator delete(void* p) noexcept
+{
+    if (p != nullptr)
+        check("operator delete");
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    if (p != nullptr)
+        check("operator delete[]");
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept { operator delete(p); }
+void operator delete[](void* p, std::size_t) noexcept { operator delete[](p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { operator delete(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { operator delete[](p); }
+
+//==============================================================================
+// Linux: the C allocator, locks and system calls, passed on to glibc
+#if defined(__linux__)
+namespace
+{
+    // Looked up on first use without a static guard, which could itself lock
+    void* next(std::atomic<void*>& cached, const char* name)
+    {
+        auto* function = cached.load(std::memory_order_relaxed);
+        if (function == nullptr)
+        {
+            function = dlsym(RTLD_NEXT, name);
+            cached.store(function, std::memory_order_relaxed);
+        }
+        return function;
+    }
+}
+
+#define RIPPLE_NEXT(name) \
+    static std::atomic<void*> next_##name { nullptr }; \
+    const auto real_##name = reinterpret_cast<decltype(&::name)>(next(next_##name, #name))
+
+extern "C"
+{
+    void* __libc_malloc(size_t);
+    void* __libc_calloc(size_t, size_t);
+    void* __libc_realloc(void*, size_t);
+    void* __libc_memalign(size_t, size_t);
+    void __libc_free(void*);
+
+    void* malloc(size_t size) __THROW
+    {
+        check("malloc");
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t count, size_t size) __THROW
+    {
+        check("calloc");
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* p, size_t size) __THROW
+    {
+        check("realloc");
+        return __libc_realloc(p, size);
+    }
+
+    void free(void* p) __THROW
+    {
+        if (p != nullptr)
+            check("free");
+        __libc_free(p);
+    }
+
+    int posix_memalign(void** result, size_t alignment, size_t size) __THROW
+    {
+        check("posix_memalign");
+        *result = __libc_memalign(alignment, size);
+        return *result != nullptr ? 0 : ENOMEM;
+    }
+
+    void* aligned_alloc(size_t alignment, size_t size) __THROW
+    {
+        check("aligned_alloc");
+        return __libc_memalign(alignment, size);
+    }
+
+    // === Locks and waits ===
+    int pthread_mutex_lock(pthread_mutex_t* mutex) __THROW
+    {
+        check("pthread_mutex_lock");
+        RIPPLE_NEXT(pthread_mutex_lock);
+        return real_pthread_mutex_lock(mutex);
+    }
+
+    int pthread_rwlock_rdlock(pthread_rwlock_t* lock) __THROW
+    {
+        check("pthread_rwlock_rdlock");
+        RIPPLE_NEXT(pthread_rwlock_rdlock);
+        return real_pthread_rwlock_rdlock(lock);
+    }
+
+    int pthread_rwlock_wrlock(pthread_rwlock_t* lock) __THROW
+    {
+        check("pthread_rwlock_wrlock");
+        RIPPLE_NEXT(pthread_rwlock_wrlock);
+        return real_pthread_rwlock_wrlock(lock);
+    }
+
+    int pthread_cond_wait(pthread_cond_t* condition, pthread_mutex_t* mutex)
+    {
+        check("pthread_cond_wait");
+        RIPPLE_NEXT(pthread_cond_wait);
+        return real_pthread_cond_wait(condition, mutex);
+    }
+
+    int pthread_cond_timedwait(pthread_cond_t* condition, pthread_mutex_t* mutex, const struct timespec* until)
+    {
+        check("pthread_cond_timedwait");
+        RIPPLE_NEXT(pthread_cond_timedwait);
+        return real_pthread_cond_timedwait(condition, mutex, until);
+    }
+
+    int pthread_cond_signal(pthread_cond_t* condition) __THROW
+    {
+        check("pthread_cond_signal");
+        RIPPLE_NEXT(pthread_cond_signal);
+        return real_pthread_cond_signal(condition);
+    }
+
+    int pthread_cond_broadcast(pthread_cond_t* condition) __THROW
+    {
+        check("pthread_cond_broadcast");
+        RIPPLE_NEXT(pthread_cond_broadcast);
+        return real_pthread_cond_broadcast(condition);
+    }
+
+    int sem_wait(sem_t* semaphore)
+    {
+        check("sem_wait");
+        RIPPLE_NEXT(sem_wait);
+        return real_sem_wait(semaphore);
+    }
+
+    int sem_timedwait(sem_t* semaphore, const struct timespec* until)
+    {
+        check("sem_timedwait");
+        RIPPLE_NEXT(sem_timedwait);
+        return real_sem_timedwait(semaphore, until);
+    }
+
+    // === Sleeping and I/O ===
+    int nanosleep(const struct timespec* duration, struct timespec* remaining)
+    {
+        check("nanosleep");
+        RIPPLE_NEXT(nanosleep);
+        return real_nanosleep(duration, remaining);
+    }
+
+    int clock_nanosleep(clockid_t clock, int flags, const struct timespec* duration, struct timespec* remaining)
+    {
+        check("clock_nanosleep");
+        RIPPLE_NEXT(clock_nanosleep);
+        return real_clock_nanosleep(clock, flags, duration, remaining);
+    }
+
+    int usleep(useconds_t microseconds)
+    {
+        check("usleep");
+        RIPPLE_NEXT(usleep);
+        return real_usleep(microseconds);
+    }
+
+    int sched_yield() __THROW
+    {
+        check("sched_yield");
+        RIPPLE_NEXT(sched_yield);
+        return real_sched_yield();
+    }
+
+    ssize_t read(int fd, void* buffer, size_t count)
+    {
+        check("read");
+        RIPPLE_NEXT(read);
+        return real_read(fd, buffer, count);
+    }
+
+    ssize_t write(int fd, const void* buffer, size_t count)
+    {
+        check("write");
+        RIPPLE_NEXT(write);
+        return real_write(fd, buffer, count);
+    }
+}
+#endif
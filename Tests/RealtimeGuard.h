@@ -0,0 +1,37 @@
+/*
+  ==============================================================================
+    RIPPLE - Realtime Guard
+    Records allocations, locks and blocking system calls made by a thread
+    marked as the audio thread. Hooks operator new/delete everywhere; on
+    Linux it also interposes malloc/free, the pthread locks and waits, and
+    the sleeping and file I/O calls.
+
+    Waking another thread with sem_post is allowed: it only makes a system
+    call when a thread is asleep on the semaphore, and never takes a lock.
+  ==============================================================================
+*/
+
+#pragma once
+
+namespace RealtimeGuard
+{
+    // Marks the calling thread as the audio thread while in scope
+    class ScopedAudioThread
+    {
+    public:
+        ScopedAudioThread();
+        ~ScopedAudioThread();
+
+        ScopedAudioThread(const ScopedAudioThread&) = delete;
+        ScopedAudioThread& operator=(const ScopedAudioThread&) = delete;
+    };
+
+    // Calls recorded since the last clear(), and the name of the first one
+    // (nullptr if none)
+    int getNumViolations();
+    const char* getFirstViolation();
+    void clear();
+
+    // False where only operator new/delete are hooked
+    bool hooksSystemCalls();
+}
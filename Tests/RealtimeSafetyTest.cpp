@@ -0,0 +1,232 @@
+/*
+  ==============================================================================
+    RIPPLE - Realtime Safety Test
+    Runs RippleProcessor::processBlock with the realtime guard on, over every
+    combination of the frame parameters (FFT size, overlap, pipelined,
+    stereo link) at a range of host block sizes. Any allocation,
+    lock or blocking system call inside processBlock fails the test.
+
+    The processor is prepared once per block size and the combinations are
+    switched between blocks, as host automation would, so mode changes are
+    covered too. Each combination hears noise with every effect and the
+    reverb on, silence with them off (long enough for the spectral state
+    to settle), then noise again.
+
+    Usage: RippleRealtimeTest [--blocks 16,64,512]
+  ==============================================================================
+*/
+
+#include "BenchmarkRunner.h"
+#include "PluginProcessor.h"
+#include "RealtimeGuard.h"
+#include <juce_gui_basics/juce_gui_basics.h>
+#include <iostream>
+
+namespace
+{
+    using RippleBench::setParameter;
+
+    constexpr double sampleRate = 48000.0;
+
+    int getNumChoices(RippleProcessor& processor, const char* id)
+    {
+        if (auto* choice = dynamic_cast<juce::AudioParameterChoice*>(processor.getAPVTS().getParameter(id)))
+            return choice->choices.size();
+
+        return 1;
+    }
+
+    struct Combination
+    {
+        int fftSize = 0;
+        int overlap = 0;
+        bool pipelined = false;
+        bool stereoLinked = false;
+        int index = 0;
+
+        juce::String describe() const
+        {
+            return "fft_size " + juce::String(fftSize) + ", overlap " + juce::String(overlap)
+                   + (pipelined ? ", pipelined" : "")
+                   + (stereoLinked ? ", linked" : "");
+        }
+    };
+
+    // Everything on, or everything off. The ripple filter and the reverb
+    // settings that rebuild their coefficients or delay lengths take a
+    // different value each time, so every stage of every combination
+    // changes them under the guard.
+    void applyEffects(RippleProcessor& processor, bool on, int variant)
+    {
+        const float step = static_cast<float>(variant % 7) / 6.0f;   // 0..1
+
+        setParameter(processor, "freeze", on ? 0.7f : 0.0f);
+        setParameter(processor, "smear", on ? 0.6f : 0.0f);
+        setParameter(processor, "scatter", on ? 0.5f : 0.0f);
+        setParameter(processor, "shift", on ? 0.3f : 0.0f);
+        setParameter(processor, "tilt", on ? 0.4f : 0.0f);
+        setParameter(processor, "feedback", on ? 0.6f : 0.0f);
+
+        // Mix 0 bypasses the filter altogether
+        setParameter(processor, "ripple_mix", on ? 0.5f + 0.5f * step : 0.0f);
+        setParameter(processor, "ripple_amount", on ? 0.8f : 0.0f);
+        setParameter(processor, "ripple_multiply", 0.1f + 0.8f * step);
+        setParameter(processor, "ripple_rate", 0.05f + 15.0f * step);
+        setParameter(processor, "ripple_width", 1.0f - step);
+        setParameter(processor, "ripple_low_bypass", 20.0f + 1500.0f * step);
+        setParameter(processor, "ripple_high_bypass", 20000.0f - 15000.0f * step);
+
+        setParameter(processor, "reverb_enabled", on ? 1.0f : 0.0f);
+        setParameter(processor, "reverb_size", step);
+        setParameter(processor, "reverb_damping", 1.0f - step);
+        setParameter(processor, "reverb_mix", on ? 0.2f + 0.8f * step : 0.0f);
+    }
+
+    // Every LFO routed somewhere, the targets moving on with each combination
+    void applyModulation(RippleProcessor& processor, int combinationIndex)
+    {
+        const int numTargets = getNumChoices(processor, ModulationEngine::targetIDs[0]);
+
+        for (int slot = 0; slot < ModulationEngine::NUM_SLOTS; ++slot)
+        {
+            setParameter(processor, ModulationEngine::sourceIDs[slot], static_cast<float>(slot + 1));
+            setParameter(processor, ModulationEngine::targetIDs[slot],
+                         static_cast<float>(1 + (combinationIndex + slot) % juce::jmax(1, numTargets - 1)));
+            setParameter(processor, ModulationEngine::depthIDs[slot], slot % 2 == 0 ? 1.0f : -1.0f);
+        }
+    }
+
+    struct Failure
+    {
+        int blockSize;
+        juce::String combination;
+        const char* stage;
+        int numViolations;
+        const char* first;
+    };
+
+    // Runs one combination, noting each stage the guard caught anything in
+    void runCombination(RippleProcessor& processor, int blockSize, const Combination& combination,
+                        juce::AudioBuffer<float>& block, juce::Random& random, juce::Array<Failure>& failures,
+                        juce::int64& numBlocks)
+    {
+        juce::MidiBuffer midi;
+        const char* const stages[] = { "noise", "silence", "noise again" };
+
+        for (int stage = 0; stage < 3; ++stage)
+        {
+            applyEffects(processor, stage != 1, combination.index * 3 + stage);
+
+            // Long enough for frames to come out the far end, measured once
+            // the first block has applied this combination's frame size
+            int stageLength = -1;
+            int position = 0;
+
+            for (int blockIndex = 0; stageLength < 0 || position < stageLength; ++blockIndex)
+            {
+                // Hosts may send less than the prepared block size
+                const int numSamples = blockIndex % 2 == 0 ? blockSize : blockSize / 3 + 1;
+
+                for (int ch = 0; ch < block.getNumChannels(); ++ch)
+                {
+                    float* data = block.getWritePointer(ch);
+                    for (int i = 0; i < numSamples; ++i)
+                        data[i] = stage == 1 ? 0.0f : (random.nextFloat() * 2.0f - 1.0f) * 0.5f;
+                }
+
+                juce::AudioBuffer<float> hostBlock(block.getArrayOfWritePointers(), block.getNumChannels(), numSamples);
+
+                {
+                    const RealtimeGuard::ScopedAudioThread audioThread;
+                    processor.processBlock(hostBlock, midi);
+                }
+
+                ++numBlocks;
+                position += numSamples;
+
+                if (stageLength < 0)
+                    stageLength = processor.getSpectralProcessor().getLatencySamples() * 2 + blockSize * 4;
+            }
+
+            if (RealtimeGuard::getNumViolations() > 0)
+            {
+                failures.add({ blockSize, combination.describe(), stages[stage],
+                               RealtimeGuard::getNumViolations(), RealtimeGuard::getFirstViolation() });
+                RealtimeGuard::clear();
+            }
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // RippleProcessor owns an APVTS, which needs the message manager to exist
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ArgumentList args(argc, argv);
+
+    juce::Array<int> blockSizes { 16, 64, 256, 441, 512, 1024, 4096 };
+    if (args.containsOption("--blocks"))
+    {
+        blockSizes.clear();
+        for (const auto& token : juce::StringArray::fromTokens(args.getValueForOption("--blocks"), ",", {}))
+            if (token.getIntValue() > 0)
+                blockSizes.add(token.getIntValue());
+    }
+
+    if (!RealtimeGuard::hooksSystemCalls())
+        std::cout << "Only operator new/delete are hooked on this platform" << std::endl;
+
+    juce::Array<Failure> failures;
+    juce::Random random(0x5249504c);
+    int numCombinations = 0;
+    juce::int64 numBlocks = 0;
+
+    for (int blockSize : blockSizes)
+    {
+        RippleProcessor processor;
+        juce::AudioBuffer<float> block(2, blockSize);
+
+        processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+
+        const int numFFTSizes = getNumChoices(processor, "fft_size");
+        const int numOverlaps = getNumChoices(processor, "overlap");
+        int combinationIndex = 0;
+
+        for (int fftSize = 0; fftSize < numFFTSizes; ++fftSize)
+        for (int overlap = 0; overlap < numOverlaps; ++overlap)
+        for (int pipelined = 0; pipelined < 2; ++pipelined)
+        for (int stereoLinked = 0; stereoLinked < 2; ++stereoLinked)
+        {
+            const int index = combinationIndex++;
+            const Combination combination { fftSize, overlap, pipelined != 0, stereoLinked != 0, index };
+
+            setParameter(processor, "fft_size", static_cast<float>(fftSize));
+            setParameter(processor, "overlap", static_cast<float>(overlap));
+            setParameter(processor, "pipelined", static_cast<float>(pipelined));
+            setParameter(processor, "stereo_link", static_cast<float>(stereoLinked));
+            applyModulation(processor, index);
+
+            // What the processor's timer does on the message thread: joins the
+            // frame pool for pipelined combinations, leaves it after them
+            processor.updateFramePool();
+
+            runCombination(processor, blockSize, combination, block, random, failures, numBlocks);
+            ++numCombinations;
+        }
+
+        processor.releaseResources();
+        std::cout << "block " << blockSize << ": " << combinationIndex << " combinations" << std::endl;
+    }
+
+    for (const auto& failure : failures)
+        std::cout << "FAIL block " << failure.blockSize << ", " << failure.combination << " (" << failure.stage
+                  << "): " << failure.numViolations << " calls, first "
+                  << (failure.first != nullptr ? failure.first : "unknown") << std::endl;
+
+    std::cout << numCombinations << " combinations, " << numBlocks << " blocks, "
+              << failures.size() << " failures" << std::endl;
+
+    return failures.isEmpty() ? 0 : 1;
+}
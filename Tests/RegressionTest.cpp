@@ -0,0 +1,385 @@
+/*
+  ==============================================================================
+    RIPPLE - Regression Test
+    Two CTest suites in one executable:
+
+    --golden <dir>  Renders a fixed input through RippleProcessor for each
+                    effect and for combinations of them, and compares every
+                    render with <dir>/<ISA>/<case>.wav, sample by sample
+                    within --tolerance (default 1e-4, -80 dBFS). Scatter's
+                    phase noise is seeded, so it is held to the samples as
+                    well. The SimdOps backends round differently, so each
+                    instruction set (SSE2, AVX2, NEON, Scalar) has its own.
+
+    --perf <file>   Times SpectralProcessor through the benchmark harness and
+                    fails when the time per frame exceeds the budget recorded
+                    in <file> for this CPU and build by more than --margin
+                    (default 0.25).
+
+    Add --update to either one to record the goldens or budgets from this
+    build. With nothing recorded for this instruction set or machine the
+    suite says so and reports as skipped; a case missing from what was
+    recorded fails.
+  ==============================================================================
+*/
+
+#include "BenchmarkRunner.h"
+#include "PluginProcessor.h"
+#include "SpectralKernels.h"
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_gui_basics/juce_gui_basics.h>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+namespace
+{
+    using RippleBench::setParameter;
+
+    // CTest's SKIP_RETURN_CODE: nothing recorded to compare against
+    constexpr int skipped = 77;
+
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 512;
+    constexpr int numChannels = 2;
+    constexpr double renderSeconds = 1.0;
+
+    //==============================================================================
+    struct GoldenCase
+    {
+        RippleBench::EffectSettings effects;
+        float rippleMix = 0.0f;
+        bool reverb = false;
+        bool pipelined = false;
+        int seed = 0;
+    };
+
+    juce::Array<GoldenCase> getGoldenCases()
+    {
+        juce::Array<GoldenCase> cases;
+
+        // Each effect alone, all of them, all of them linked
+        for (const auto& effects : RippleBench::getEffectMatrix())
+            cases.add({ effects });
+
+        GoldenCase pair;
+        pair.effects.name = "freeze-smear";   pair.effects.freeze = 0.8f;  pair.effects.smear = 0.7f;    cases.add(pair); pair = {};
+        pair.effects.name = "shift-tilt";     pair.effects.shift = 0.5f;   pair.effects.tilt = -0.6f;    cases.add(pair); pair = {};
+        pair.effects.name = "smear-feedback"; pair.effects.smear = 0.7f;   pair.effects.feedback = 0.6f; cases.add(pair); pair = {};
+
+        // A different seed has to give different noise, and the same one again
+        GoldenCase seeded;
+        seeded.effects.name = "scatter-seed-7";
+        seeded.effects.scatter = 0.5f;
+        seeded.seed = 7;
+        cases.add(seeded);
+
+        // The whole chain
+        GoldenCase full;
+        full.effects.name = "full-chain";
+        full.effects.freeze = 0.6f;
+        full.effects.smear = 0.5f;
+        full.effects.scatter = 0.3f;
+        full.effects.shift = 0.25f;
+        full.effects.tilt = 0.4f;
+        full.effects.feedback = 0.4f;
+        full.rippleMix = 0.5f;
+        full.reverb = true;
+        cases.add(full);
+
+        full.effects.name = "full-chain-pipelined";
+        full.pipelined = true;
+        cases.add(full);
+
+        GoldenCase ripple;
+        ripple.effects.name = "ripple";
+        ripple.rippleMix = 1.0f;
+        cases.add(ripple);
+
+        GoldenCase reverb;
+        reverb.effects.name = "reverb";
+        reverb.reverb = true;
+        cases.add(reverb);
+
+        return cases;
+    }
+
+    // Sweep with impulses on top: every band, and transients for the smear
+    // and feedback tails
+    juce::AudioBuffer<float> makeInput()
+    {
+        const int numSamples = static_cast<int>(sampleRate * renderSeconds);
+
+        auto input = RippleBench::makeSyntheticInput("sweep", sampleRate, numChannels, numSamples);
+        const auto impulses = RippleBench::makeSyntheticInput("impulses", sampleRate, numChannels, numSamples);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            input.applyGain(ch, 0, numSamples, 0.6f);
+            input.addFrom(ch, 0, impulses, ch, 0, numSamples, 0.4f);
+        }
+
+        return input;
+    }
+
+    juce::AudioBuffer<float> render(const GoldenCase& test, const juce::AudioBuffer<float>& input)
+    {
+        RippleProcessor processor;
+
+        const auto& fx = test.effects;
+        setParameter(processor, "freeze", fx.freeze);
+        setParameter(processor, "smear", fx.smear);
+        setParameter(processor, "scatter", fx.scatter);
+        setParameter(processor, "shift", fx.shift);
+        setParameter(processor, "tilt", fx.tilt);
+        setParameter(processor, "feedback", fx.feedback);
+        setParameter(processor, "stereo_link", fx.stereoLinked ? 1.0f : 0.0f);
+        setParameter(processor, "ripple_mix", test.rippleMix);
+        setParameter(processor, "reverb_enabled", test.reverb ? 1.0f : 0.0f);
+        setParameter(processor, "pipelined", test.pipelined ? 1.0f : 0.0f);
+        setParameter(processor, "random_seed", static_cast<float>(test.seed));
+
+        processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+
+        juce::AudioBuffer<float> output(input);
+        juce::MidiBuffer midi;
+
+        for (int pos = 0; pos < output.getNumSamples(); pos += blockSize)
+        {
+            const int count = juce::jmin(blockSize, output.getNumSamples() - pos);
+            juce::AudioBuffer<float> block(output.getArrayOfWritePointers(), numChannels, pos, count);
+            processor.processBlock(block, midi);
+        }
+
+        processor.releaseResources();
+        return output;
+    }
+
+    //==============================================================================
+    bool writeWav(const juce::File& file, const juce::AudioBuffer<float>& buffer)
+    {
+        file.deleteFile();
+        auto stream = std::make_unique<juce::FileOutputStream>(file);
+        if (!stream->openedOk())
+            return false;
+
+        // 24-bit: quantisation far below the tolerance, a quarter smaller than float
+        juce::WavAudioFormat format;
+        std::unique_ptr<juce::AudioFormatWriter> writer(format.createWriterFor(stream.get(), sampleRate,
+                                                                               static_cast<unsigned int>(buffer.getNumChannels()),
+                                                                               24, {}, 0));
+        if (writer == nullptr)
+            return false;
+
+        stream.release();
+        return writer->writeFromAudioSampleBuffer(buffer, 0, buffer.getNumSamples());
+    }
+
+    juce::AudioBuffer<float> readWav(const juce::File& file)
+    {
+        if (!file.existsAsFile())
+            return {};
+
+        juce::WavAudioFormat format;
+        std::unique_ptr<juce::AudioFormatReader> reader(format.createReaderFor(file.createInputStream().release(), true));
+        if (reader == nullptr)
+            return {};
+
+        juce::AudioBuffer<float> buffer(static_cast<int>(reader->numChannels), static_cast<int>(reader->lengthInSamples));
+        reader->read(&buffer, 0, buffer.getNumSamples(), 0, true, true);
+        return buffer;
+    }
+
+    //==============================================================================
+    int runGolden(const juce::File& root, bool update, float tolerance)
+    {
+        const auto input = makeInput();
+        const auto directory = root.getChildFile(SpectralKernels::getInstructionSetName());
+
+        if (!update && directory.findChildFiles(juce::File::findFiles, false, "*.wav").isEmpty())
+        {
+            std::cout << "SKIP: no golden renders for " << SpectralKernels::getInstructionSetName() << " in "
+                      << directory.getFullPathName() << ". NOTHING WAS CHECKED. Record them with --update"
+                      << " on a clean build and commit them." << std::endl;
+            return skipped;
+        }
+
+        directory.createDirectory();
+        int failures = 0;
+
+        for (const auto& test : getGoldenCases())
+        {
+            const auto output = render(test, input);
+            const auto file = directory.getChildFile(test.effects.name + ".wav");
+
+            if (update)
+            {
+                const bool written = writeWav(file, output);
+                std::cout << (written ? "Recorded " : "Could not write ") << file.getFullPathName() << std::endl;
+                failures += written ? 0 : 1;
+                continue;
+            }
+
+            const auto golden = readWav(file);
+            if (golden.getNumChannels() != output.getNumChannels() || golden.getNumSamples() != output.getNumSamples())
+            {
+                std::cout << "FAIL " << test.effects.name << ": golden render missing or a different length" << std::endl;
+                ++failures;
+                continue;
+            }
+
+            float maxDiff = 0.0f;
+            double sumSquares = 0.0;
+
+            for (int ch = 0; ch < output.getNumChannels(); ++ch)
+            {
+                for (int i = 0; i < output.getNumSamples(); ++i)
+                {
+                    const float diff = output.getSample(ch, i) - golden.getSample(ch, i);
+                    maxDiff = juce::jmax(maxDiff, std::abs(diff));
+                    sumSquares += static_cast<double>(diff) * diff;
+                }
+            }
+
+            const double rms = std::sqrt(sumSquares / (output.getNumChannels() * output.getNumSamples()));
+            const bool passed = maxDiff <= tolerance;
+
+            std::cout << (passed ? "PASS " : "FAIL ") << test.effects.name << ": max diff " << maxDiff
+                      << ", rms " << juce::Decibels::gainToDecibels(rms, -200.0) << " dB" << std::endl;
+            failures += passed ? 0 : 1;
+        }
+
+        return failures == 0 ? 0 : 1;
+    }
+
+    //==============================================================================
+    juce::String getMachineKey()
+    {
+       #if JUCE_DEBUG
+        juce::String build = "debug";
+       #else
+        juce::String build = "release";
+       #endif
+
+        build << "-" << juce::String(SpectralKernels::getInstructionSetName()).toLowerCase();
+
+        return juce::SystemStats::getCpuModel().trim() + " / " + build;
+    }
+
+    // Best of a few runs, so a busy moment on the machine doesn't fail it
+    double measureNsPerFrame(const RippleBench::BenchConfig& config, const juce::AudioBuffer<float>& input)
+    {
+        double best = std::numeric_limits<double>::max();
+
+        for (int run = 0; run < 3; ++run)
+        {
+            const auto result = RippleBench::run(config, input, "noise");
+            if (result.numFrames > 0)
+                best = juce::jmin(best, result.meanBlockNs * static_cast<double>(result.numBlocks)
+                                            / static_cast<double>(result.numFrames));
+        }
+
+        return best;
+    }
+
+    int runPerformance(const juce::File& budgetFile, bool update, double margin)
+    {
+        const auto machine = getMachineKey();
+        auto budgets = juce::JSON::parse(budgetFile);
+        if (!budgets.isObject())
+            budgets = juce::var(new juce::DynamicObject());
+
+        const auto recorded = budgets.getProperty(machine, {});
+        if (!update && !recorded.isObject())
+        {
+            std::cout << "SKIP: no budgets for \"" << machine << "\" in " << budgetFile.getFullPathName()
+                      << ". NOTHING WAS CHECKED. Record them on this machine with --update." << std::endl;
+            return skipped;
+        }
+
+        const auto input = RippleBench::makeSyntheticInput("noise", sampleRate, numChannels,
+                                                           static_cast<int>(sampleRate));
+        juce::DynamicObject::Ptr measured = new juce::DynamicObject();
+        int failures = 0;
+
+        for (int fftOrder = 9; fftOrder <= 12; ++fftOrder)
+        {
+            for (const auto& effects : RippleBench::getEffectMatrix())
+            {
+                if (effects.name != "dry" && effects.name != "all")
+                    continue;
+
+                RippleBench::BenchConfig config;
+                config.sampleRate = sampleRate;
+                config.blockSize = blockSize;
+                config.numChannels = numChannels;
+                config.seconds = 0.5;
+                config.warmupSeconds = 0.1;
+                config.fftOrder = fftOrder;
+                config.effects = effects;
+
+                const juce::String name = "fft" + juce::String(1 << fftOrder) + "-" + effects.name;
+                const double nsPerFrame = measureNsPerFrame(config, input);
+                measured->setProperty(name, nsPerFrame);
+
+                if (update)
+                {
+                    std::cout << "Recorded " << name << ": " << juce::String(nsPerFrame, 0) << " ns/frame" << std::endl;
+                    continue;
+                }
+
+                const double budget = recorded.getProperty(name, 0.0);
+                if (budget <= 0.0)
+                {
+                    std::cout << "FAIL " << name << ": no budget recorded" << std::endl;
+                    ++failures;
+                    continue;
+                }
+
+                const bool passed = nsPerFrame <= budget * (1.0 + margin);
+                std::cout << (passed ? "PASS " : "FAIL ") << name << ": " << juce::String(nsPerFrame, 0)
+                          << " ns/frame, budget " << juce::String(budget, 0) << std::endl;
+                failures += passed ? 0 : 1;
+            }
+        }
+
+        if (update)
+        {
+            budgets.getDynamicObject()->setProperty(machine, juce::var(measured.get()));
+            if (!budgetFile.replaceWithText(juce::JSON::toString(budgets)))
+            {
+                std::cout << "Could not write " << budgetFile.getFullPathName() << std::endl;
+                return 1;
+            }
+        }
+
+        return failures == 0 ? 0 : 1;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // RippleProcessor owns an APVTS, which needs the message manager to exist
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ArgumentList args(argc, argv);
+    const bool update = args.containsOption("--update");
+
+    if (args.containsOption("--golden"))
+    {
+        const auto tolerance = args.getValueForOption("--tolerance");
+        return runGolden(args.getFileForOption("--golden"), update,
+                         tolerance.isNotEmpty() ? tolerance.getFloatValue() : 1.0e-4f);
+    }
+
+    if (args.containsOption("--perf"))
+    {
+        const auto margin = args.getValueForOption("--margin");
+        return runPerformance(args.getFileForOption("--perf"), update,
+                              margin.isNotEmpty() ? margin.getDoubleValue() : 0.25);
+    }
+
+    std::cout << "Usage: RippleRegressionTest --golden <dir> | --perf <budgets.json> [--update]" << std::endl;
+    return 1;
+}
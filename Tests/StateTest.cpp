@@ -0,0 +1,222 @@
+/*
+  ==============================================================================
+    RIPPLE - State Test
+    Saves and recalls RippleProcessor's session state:
+
+    round trip   Every parameter off its default and a frozen spectrum come
+                 back from getStateInformation through setStateInformation,
+                 the spectrum within its 16-bit dB codes.
+    legacy xml   A version 2 session (the APVTS tree as XML) still loads.
+    truncated    Every shorter prefix of a saved blob is turned away and
+                 leaves the parameters and the frozen spectrum as they were.
+  ==============================================================================
+*/
+
+#include "BenchmarkRunner.h"
+#include "PluginProcessor.h"
+#include <juce_gui_basics/juce_gui_basics.h>
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+    using RippleBench::setParameter;
+
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 512;
+
+    // Half a 16-bit dB code is 0.0014 dB
+    constexpr float frozenToleranceDb = 0.01f;
+    constexpr float frozenFloorDb = -150.0f;
+
+    juce::Array<float> getParameterValues(RippleProcessor& processor)
+    {
+        juce::Array<float> values;
+        for (auto* parameter : processor.getParameters())
+            values.add(parameter->getValue());
+
+        return values;
+    }
+
+    // The first parameter that differs, or an empty string
+    juce::String compareParameters(RippleProcessor& processor, const juce::Array<float>& expected)
+    {
+        const auto values = getParameterValues(processor);
+        const auto& parameters = processor.getParameters();
+
+        for (int i = 0; i < values.size(); ++i)
+            if (std::abs(values[i] - expected[i]) > 1.0e-5f)
+                return parameters[i]->getName(64) + " is " + juce::String(values[i]) + ", expected "
+                       + juce::String(expected[i]);
+
+        return {};
+    }
+
+    void prepare(RippleProcessor& processor)
+    {
+        processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+    }
+
+    void process(RippleProcessor& processor, double seconds, bool noise)
+    {
+        juce::Random random(0x5249504c);
+        juce::AudioBuffer<float> block(2, blockSize);
+        juce::MidiBuffer midi;
+
+        for (int pos = 0; pos < static_cast<int>(seconds * sampleRate); pos += blockSize)
+        {
+            for (int ch = 0; ch < block.getNumChannels(); ++ch)
+                for (int i = 0; i < blockSize; ++i)
+                    block.setSample(ch, i, noise ? (random.nextFloat() * 2.0f - 1.0f) * 0.5f : 0.0f);
+
+            processor.processBlock(block, midi);
+        }
+    }
+
+    // Every parameter moved off its default, then a spectrum frozen from
+    // noise. Freeze goes back to 0 afterwards, which holds the spectrum
+    // as it is, and nothing modulates it.
+    void makeSession(RippleProcessor& processor)
+    {
+        for (auto* parameter : processor.getParameters())
+            parameter->setValueNotifyingHost(std::fmod(parameter->getDefaultValue() + 0.37f, 1.0f));
+
+        for (const auto* id : ModulationEngine::depthIDs)
+            setParameter(processor, id, 0.0f);
+
+        setParameter(processor, "pipelined", 0.0f);
+        setParameter(processor, "freeze", 0.8f);
+
+        prepare(processor);
+        process(processor, 1.0, true);
+
+        setParameter(processor, "freeze", 0.0f);
+        process(processor, 0.1, true);
+    }
+
+    // The first bin that differs by more than the quantisation, or an empty string
+    juce::String compareFrozen(const SpectralProcessor::FrozenSpectrum& spectrum,
+                               const SpectralProcessor::FrozenSpectrum& expected)
+    {
+        if (spectrum.numBins != expected.numBins || spectrum.fftSize != expected.fftSize
+            || spectrum.magnitude.size() != expected.magnitude.size())
+            return "frozen spectrum has " + juce::String(spectrum.numBins) + " bins, expected "
+                   + juce::String(expected.numBins);
+
+        for (size_t i = 0; i < expected.magnitude.size(); ++i)
+        {
+            const float db = juce::Decibels::gainToDecibels(spectrum.magnitude[i], frozenFloorDb);
+            const float expectedDb = juce::Decibels::gainToDecibels(expected.magnitude[i], frozenFloorDb);
+
+            if (std::abs(db - expectedDb) > frozenToleranceDb)
+                return "frozen bin " + juce::String(static_cast<int>(i)) + " is " + juce::String(db, 4)
+                       + " dB, expected " + juce::String(expectedDb, 4) + " dB";
+        }
+
+        return {};
+    }
+
+    //==============================================================================
+    juce::String testRoundTrip()
+    {
+        RippleProcessor source;
+        makeSession(source);
+
+        juce::MemoryBlock state;
+        source.getStateInformation(state);
+
+        const auto expectedParameters = getParameterValues(source);
+        const auto expectedFrozen = source.getSpectralProcessor().getFrozenSpectrum();
+        if (expectedFrozen.numBins == 0)
+            return "nothing frozen to save";
+
+        // As a host restores a session: state first, then prepare and play.
+        // The spectrum is taken up by the first frame.
+        RippleProcessor restored;
+        restored.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+        prepare(restored);
+        process(restored, 0.1, false);
+
+        auto failure = compareParameters(restored, expectedParameters);
+        if (failure.isEmpty())
+            failure = compareFrozen(restored.getSpectralProcessor().getFrozenSpectrum(), expectedFrozen);
+
+        return failure;
+    }
+
+    juce::String testLegacyXml()
+    {
+        RippleProcessor source;
+        for (auto* parameter : source.getParameters())
+            parameter->setValueNotifyingHost(std::fmod(parameter->getDefaultValue() + 0.37f, 1.0f));
+
+        // What getStateInformation wrote before the binary format
+        std::unique_ptr<juce::XmlElement> xml(source.getAPVTS().copyState().createXml());
+        xml->setAttribute("stateVersion", 2);
+
+        juce::MemoryBlock state;
+        juce::AudioProcessor::copyXmlToBinary(*xml, state);
+
+        RippleProcessor restored;
+        restored.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+
+        return compareParameters(restored, getParameterValues(source));
+    }
+
+    juce::String testTruncated()
+    {
+        RippleProcessor source;
+        makeSession(source);
+
+        juce::MemoryBlock state;
+        source.getStateInformation(state);
+
+        // Defaults and nothing frozen, so anything taken up from the blob shows
+        RippleProcessor target;
+        const auto expectedParameters = getParameterValues(target);
+
+        for (size_t length = 0; length < state.getSize(); ++length)
+        {
+            target.setStateInformation(state.getData(), static_cast<int>(length));
+
+            const auto failure = compareParameters(target, expectedParameters);
+            if (failure.isNotEmpty())
+                return "accepted " + juce::String(static_cast<int>(length)) + " of "
+                       + juce::String(static_cast<int>(state.getSize())) + " bytes: " + failure;
+        }
+
+        prepare(target);
+        process(target, 0.1, false);
+
+        if (target.getSpectralProcessor().getFrozenSpectrum().numBins != 0)
+            return "a truncated blob queued a frozen spectrum";
+
+        return {};
+    }
+}
+
+int main()
+{
+    // RippleProcessor owns an APVTS, which needs the message manager to exist
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    struct Test { const char* name; juce::String (*run)(); };
+    const Test tests[] = {
+        { "round trip", testRoundTrip },
+        { "legacy xml", testLegacyXml },
+        { "truncated", testTruncated },
+    };
+
+    int failures = 0;
+
+    for (const auto& test : tests)
+    {
+        const auto failure = test.run();
+        std::cout << (failure.isEmpty() ? "PASS " : "FAIL ") << test.name
+                  << (failure.isEmpty() ? "" : ": " + failure) << std::endl;
+        failures += failure.isEmpty() ? 0 : 1;
+    }
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,151 @@
+/*
+  ==============================================================================
+    RIPPLE - Offline Renderer Implementation
+  ==============================================================================
+*/
+
+#include "OfflineRenderer.h"
+#include "PluginProcessor.h"
+
+namespace RippleRender
+{
+    juce::StringArray applySettings(RippleProcessor& processor, const RenderSettings& settings)
+    {
+        if (settings.state.getSize() > 0)
+            processor.setStateInformation(settings.state.getData(), static_cast<int>(settings.state.getSize()));
+
+        juce::StringArray unknown;
+
+        if (auto* object = settings.parameters.getDynamicObject())
+        {
+            for (const auto& property : object->getProperties())
+            {
+                if (auto* param = processor.getAPVTS().getParameter(property.name.toString()))
+                    param->setValueNotifyingHost(param->convertTo0to1(static_cast<float>(property.value)));
+                else
+                    unknown.add(property.name.toString());
+            }
+        }
+
+        return unknown;
+    }
+
+    RenderResult renderFile(RippleProcessor& processor, const RenderSettings& settings,
+                            const juce::File& input, const juce::File& output)
+    {
+        RenderResult result;
+        const auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+
+        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(input));
+        if (reader == nullptr)
+        {
+            result.error = "can't read " + input.getFullPathName();
+            return result;
+        }
+
+        const int numChannels = static_cast<int>(reader->numChannels);
+        const double sampleRate = reader->sampleRate;
+        if (numChannels < 1 || numChannels > 2)
+        {
+            result.error = juce::String(numChannels) + " channels, only mono and stereo are supported";
+            return result;
+        }
+
+        // Same format as the input, by extension
+        auto* format = formatManager.findFormatForFileExtension(input.getFileExtension());
+        if (format == nullptr)
+        {
+            result.error = "no writer for " + input.getFileExtension();
+            return result;
+        }
+
+        const int bitsPerSample = format->getPossibleBitDepths().contains(static_cast<int>(reader->bitsPerSample))
+                                      ? static_cast<int>(reader->bitsPerSample)
+                                      : 24;
+
+        output.deleteFile();
+        auto stream = std::make_unique<juce::FileOutputStream>(output);
+        if (!stream->openedOk())
+        {
+            result.error = "can't write " + output.getFullPathName();
+            return result;
+        }
+
+        std::unique_ptr<juce::AudioFormatWriter> writer(format->createWriterFor(stream.get(), sampleRate,
+                                                                                static_cast<unsigned int>(numChannels),
+                                                                                bitsPerSample, reader->metadataValues, 0));
+        if (writer == nullptr)
+        {
+            result.error = "can't write " + juce::String(bitsPerSample) + "-bit " + format->getFormatName();
+            return result;
+        }
+
+        stream.release();   // The writer owns it now
+
+        // === Prepare for this file ===
+        const auto channelSet = juce::AudioChannelSet::canonicalChannelSet(numChannels);
+        juce::AudioProcessor::BusesLayout layout;
+        layout.inputBuses.add(channelSet);
+        layout.outputBuses.add(channelSet);
+
+        if (!processor.setBusesLayout(layout))
+        {
+            result.error = "unsupported channel layout";
+            return result;
+        }
+
+        processor.setNonRealtime(true);
+        processor.setRateAndBufferSizeDetails(sampleRate, settings.blockSize);
+        processor.prepareToPlay(sampleRate, settings.blockSize);
+
+        // The first latency's worth of output is dropped and made up at the
+        // end, so the render lines up with the input
+        const auto latency = static_cast<juce::int64>(processor.getLatencySamples());
+        const juce::int64 outputLength = reader->lengthInSamples
+                                         + static_cast<juce::int64>(settings.tailSeconds * sampleRate);
+        const juce::int64 totalLength = outputLength + latency;
+
+        juce::AudioBuffer<float> chunk(numChannels, settings.chunkSize);
+        juce::MidiBuffer midi;
+        juce::int64 toSkip = latency;
+
+        for (juce::int64 position = 0; position < totalLength;)
+        {
+            const int count = static_cast<int>(juce::jmin<juce::int64>(settings.chunkSize, totalLength - position));
+
+            // Reads past the end of the file come back as silence
+            reader->read(&chunk, 0, count, position, true, true);
+
+            for (int offset = 0; offset < count; offset += settings.blockSize)
+            {
+                const int blockLength = juce::jmin(settings.blockSize, count - offset);
+                juce::AudioBuffer<float> block(chunk.getArrayOfWritePointers(), numChannels, offset, blockLength);
+                processor.processBlock(block, midi);
+            }
+
+            const int skip = static_cast<int>(juce::jmin<juce::int64>(toSkip, count));
+            toSkip -= skip;
+
+            if (count > skip && !writer->writeFromAudioSampleBuffer(chunk, skip, count - skip))
+            {
+                processor.releaseResources();
+                result.error = "write failed for " + output.getFullPathName();
+                return result;
+            }
+
+            position += count;
+        }
+
+        processor.releaseResources();
+        writer.reset();   // Flushes and finalises the header
+
+        result.succeeded = true;
+        result.numSamples = outputLength;
+        result.sampleRate = sampleRate;
+        result.seconds = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+        return result;
+    }
+}
@@ -0,0 +1,47 @@
+/*
+  ==============================================================================
+    RIPPLE - Offline Renderer
+    Streams audio files through RippleProcessor without an editor or a host.
+    Files are read and written a chunk at a time, so memory stays the same
+    however long the file is.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+
+class RippleProcessor;
+
+namespace RippleRender
+{
+    struct RenderSettings
+    {
+        int blockSize = 512;         // Host block size the processor sees
+        int chunkSize = 1 << 16;     // Samples per read and write
+        double tailSeconds = 0.0;    // Rendered past the end of the input
+        juce::MemoryBlock state;     // From getStateInformation(), applied first
+        juce::var parameters;        // { "id": value } in parameter units, over the state
+    };
+
+    struct RenderResult
+    {
+        bool succeeded = false;
+        juce::String error;
+        juce::int64 numSamples = 0;  // Written per channel
+        double sampleRate = 0.0;
+        double seconds = 0.0;        // Wall time
+    };
+
+    // Applies the state and parameters; the message thread, before rendering.
+    // Returns the parameter IDs it didn't recognise.
+    juce::StringArray applySettings(RippleProcessor& processor, const RenderSettings& settings);
+
+    // Renders one file, latency compensated, into the same format and bit
+    // depth (24 if the format can't write the input's). The processor is
+    // prepared for the file's channel count and sample rate; mono and
+    // stereo files only.
+    RenderResult renderFile(RippleProcessor& processor, const RenderSettings& settings,
+                            const juce::File& input, const juce::File& output);
+}
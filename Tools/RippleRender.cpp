@@ -0,0 +1,189 @@
+/*
+  ==============================================================================
+    RIPPLE - Offline Batch Renderer
+    Renders WAV/AIFF files through Ripple in parallel: one RippleProcessor per
+    worker thread, each taking the next file off the list until none are left.
+
+    Usage:
+      RippleRender [--state preset.bin] [--params params.json]
+                   [--output-dir dir] [--suffix _ripple] [--jobs N]
+                   [--block 512] [--chunk 65536] [--tail seconds]
+                   file.wav [file.aif ...]
+
+    --state is a blob saved by the plugin (getStateInformation); --params is
+    a JSON object of parameter IDs to values in parameter units, applied on
+    top, e.g. { "freeze": 0.6, "reverb_enabled": 1 }. Output goes next to
+    each input unless --output-dir is given, named <input><suffix>.<ext>.
+  ==============================================================================
+*/
+
+#include "OfflineRenderer.h"
+#include "PluginProcessor.h"
+#include <juce_gui_basics/juce_gui_basics.h>
+#include <atomic>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    const juce::StringArray valueOptions { "--state", "--params", "--output-dir", "--suffix",
+                                           "--jobs", "--block", "--chunk", "--tail" };
+
+    // Options take "--name value" or "--name=value"; anything else is a file
+    struct CommandLine
+    {
+        juce::StringPairArray options;
+        juce::StringArray files;
+        juce::String error;
+    };
+
+    CommandLine parseCommandLine(int argc, char* argv[])
+    {
+        CommandLine commandLine;
+
+        for (int i = 1; i < argc; ++i)
+        {
+            const juce::String arg(argv[i]);
+
+            if (!arg.startsWith("--"))
+            {
+                commandLine.files.add(arg);
+                continue;
+            }
+
+            const auto name = arg.upToFirstOccurrenceOf("=", false, false);
+            if (!valueOptions.contains(name))
+            {
+                commandLine.error = "unknown option " + name;
+                break;
+            }
+
+            if (arg.containsChar('='))
+                commandLine.options.set(name, arg.fromFirstOccurrenceOf("=", false, false));
+            else if (i + 1 < argc)
+                commandLine.options.set(name, argv[++i]);
+            else
+                commandLine.error = name + " needs a value";
+        }
+
+        return commandLine;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // RippleProcessor owns an APVTS, which needs the message manager to exist
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    const auto commandLine = parseCommandLine(argc, argv);
+    const auto& options = commandLine.options;
+
+    if (commandLine.error.isNotEmpty() || commandLine.files.isEmpty())
+    {
+        std::cerr << (commandLine.error.isNotEmpty() ? commandLine.error : juce::String("no input files"))
+                  << "\nUsage: RippleRender [--state preset.bin] [--params params.json] [--output-dir dir]"
+                     " [--suffix _ripple] [--jobs N] [--block 512] [--chunk 65536] [--tail seconds] files..."
+                  << std::endl;
+        return 1;
+    }
+
+    const auto cwd = juce::File::getCurrentWorkingDirectory();
+
+    RippleRender::RenderSettings settings;
+    settings.blockSize = juce::jlimit(16, 8192, options.getValue("--block", "512").getIntValue());
+    settings.chunkSize = juce::jmax(settings.blockSize, options.getValue("--chunk", "65536").getIntValue());
+    settings.tailSeconds = juce::jmax(0.0, options.getValue("--tail", "0").getDoubleValue());
+
+    if (options.containsKey("--state"))
+    {
+        const auto stateFile = cwd.getChildFile(options["--state"]);
+        if (!stateFile.loadFileAsData(settings.state))
+        {
+            std::cerr << "Could not read state " << stateFile.getFullPathName() << std::endl;
+            return 1;
+        }
+    }
+
+    if (options.containsKey("--params"))
+    {
+        const auto paramsFile = cwd.getChildFile(options["--params"]);
+        settings.parameters = juce::JSON::parse(paramsFile);
+        if (!settings.parameters.isObject())
+        {
+            std::cerr << "Could not read a JSON object from " << paramsFile.getFullPathName() << std::endl;
+            return 1;
+        }
+    }
+
+    // Resolve every output up front so a bad path fails before any rendering
+    const auto suffix = options.getValue("--suffix", "_ripple");
+    const auto outputDir = options.containsKey("--output-dir") ? cwd.getChildFile(options["--output-dir"]) : juce::File();
+    if (outputDir != juce::File() && !outputDir.createDirectory())
+    {
+        std::cerr << "Could not create " << outputDir.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    juce::Array<juce::File> inputs, outputs;
+    for (const auto& path : commandLine.files)
+    {
+        const auto input = cwd.getChildFile(path);
+        const auto directory = outputDir != juce::File() ? outputDir : input.getParentDirectory();
+        inputs.add(input);
+        outputs.add(directory.getChildFile(input.getFileNameWithoutExtension() + suffix + input.getFileExtension()));
+    }
+
+    // One processor per worker, set up here on the message thread
+    const int numJobs = juce::jlimit(1, inputs.size(), options.getValue("--jobs", juce::String(juce::SystemStats::getNumCpus())).getIntValue());
+
+    std::vector<std::unique_ptr<RippleProcessor>> processors;
+    for (int i = 0; i < numJobs; ++i)
+    {
+        processors.push_back(std::make_unique<RippleProcessor>());
+        const auto unknown = RippleRender::applySettings(*processors.back(), settings);
+
+        if (i == 0 && !unknown.isEmpty())
+            std::cerr << "Ignoring unknown parameters: " << unknown.joinIntoString(", ") << std::endl;
+    }
+
+    std::atomic<int> nextFile { 0 };
+    std::atomic<int> numFailed { 0 };
+    std::mutex outputLock;
+
+    auto worker = [&](RippleProcessor& processor)
+    {
+        for (int index = nextFile++; index < inputs.size(); index = nextFile++)
+        {
+            const auto result = RippleRender::renderFile(processor, settings, inputs[index], outputs[index]);
+
+            const std::lock_guard<std::mutex> lock(outputLock);
+            if (result.succeeded)
+            {
+                const double audioSeconds = static_cast<double>(result.numSamples) / result.sampleRate;
+                std::cout << outputs[index].getFullPathName() << ": " << juce::String(audioSeconds, 1) << " s in "
+                          << juce::String(result.seconds, 1) << " s ("
+                          << juce::String(audioSeconds / juce::jmax(1.0e-6, result.seconds), 1) << "x realtime)" << std::endl;
+            }
+            else
+            {
+                ++numFailed;
+                std::cerr << inputs[index].getFullPathName() << ": " << result.error << std::endl;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (auto& processor : processors)
+        threads.emplace_back(worker, std::ref(*processor));
+
+    for (auto& thread : threads)
+        thread.join();
+
+    std::cout << inputs.size() - numFailed.load() << " of " << inputs.size() << " files rendered with "
+              << numJobs << (numJobs == 1 ? " job" : " jobs") << std::endl;
+
+    return numFailed.load() == 0 ? 0 : 1;
+}
@@ -0,0 +1,37 @@
+/**
+ * Decoder for the binary spectrumData payload.
+ *
+ * The editor sends each curve (spectrum, frozen, peaks) as `bands` 8-bit
+ * values, concatenated and base64 encoded. Decoding writes straight into
+ * preallocated Float32Arrays: no atob(), no intermediate arrays, so a
+ * 30 Hz event stream doesn't generate garbage.
+ */
+
+const BASE64_ALPHABET = 'ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/';
+
+const BASE64_LOOKUP = (() => {
+  const table = new Uint8Array(128);
+  for (let i = 0; i < BASE64_ALPHABET.length; i++) table[BASE64_ALPHABET.charCodeAt(i)] = i;
+  return table;
+})();
+
+/**
+ * Decodes `payload` into `targets` (each at least `bands` long), in order.
+ * Values are scaled back to 0..1.
+ */
+export function decodeSpectrumPayload(payload: string, bands: number, targets: Float32Array[]): void {
+  const total = bands * targets.length;
+  let byteIndex = 0;
+
+  for (let i = 0; i + 3 < payload.length && byteIndex < total; i += 4) {
+    const triple = (BASE64_LOOKUP[payload.charCodeAt(i) & 127] << 18)
+                 | (BASE64_LOOKUP[payload.charCodeAt(i + 1) & 127] << 12)
+                 | (BASE64_LOOKUP[payload.charCodeAt(i + 2) & 127] << 6)
+                 | BASE64_LOOKUP[payload.charCodeAt(i + 3) & 127];
+
+    for (let shift = 16; shift >= 0 && byteIndex < total; shift -= 8, byteIndex++) {
+      const curve = (byteIndex / bands) | 0;
+      targets[curve][byteIndex - curve * bands] = ((triple >> shift) & 255) / 255;
+    }
+  }
+}